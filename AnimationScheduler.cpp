@@ -0,0 +1,69 @@
+#include "AnimationScheduler.h"
+#include <algorithm>
+
+AnimationScheduler::AnimationScheduler(QWidget* target)
+    : target(target), timer(new QTimer(target)), suspended(false) {
+    timer->setSingleShot(true);
+    QObject::connect(timer, &QTimer::timeout, target, [this]() { onTimeout(); });
+    clock.start();
+}
+
+int AnimationScheduler::add(int intervalMs, Step step) {
+    animations.push_back(Animation{std::max(1, intervalMs), std::move(step), false, 0});
+    return static_cast<int>(animations.size()) - 1;
+}
+
+void AnimationScheduler::setActive(int id, bool active) {
+    Animation& animation = animations[id];
+    if (animation.active == active) return;
+    animation.active = active;
+    animation.dueMs = clock.elapsed() + animation.intervalMs;
+    reschedule();
+}
+
+void AnimationScheduler::setSuspended(bool suspend) {
+    if (suspended == suspend) return;
+    suspended = suspend;
+    if (!suspended) {
+        // 挂起期间的时间不补帧，恢复后各动画从下一个间隔开始
+        const qint64 now = clock.elapsed();
+        for (Animation& animation : animations) {
+            animation.dueMs = now + animation.intervalMs;
+        }
+    }
+    reschedule();
+}
+
+void AnimationScheduler::onTimeout() {
+    const qint64 now = clock.elapsed();
+    QRegion dirty;
+    for (Animation& animation : animations) {
+        if (!animation.active || animation.dueMs > now) continue;
+        dirty += animation.step();
+        // 落后超过一帧（事件循环繁忙）时不补帧，下一帧从现在起再等一个完整的间隔
+        animation.dueMs += animation.intervalMs;
+        if (animation.dueMs <= now) {
+            animation.dueMs = now + animation.intervalMs;
+        }
+    }
+    if (!dirty.isEmpty()) {
+        target->update(dirty);
+    }
+    reschedule();
+}
+
+void AnimationScheduler::reschedule() {
+    qint64 nextDue = -1;
+    if (!suspended) {
+        for (const Animation& animation : animations) {
+            if (animation.active && (nextDue < 0 || animation.dueMs < nextDue)) {
+                nextDue = animation.dueMs;
+            }
+        }
+    }
+    if (nextDue < 0) {
+        timer->stop();
+        return;
+    }
+    timer->start(static_cast<int>(std::max<qint64>(0, nextDue - clock.elapsed())));
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef ANIMATIONSCHEDULER_H
+#define ANIMATIONSCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QRegion>
+#include <QTimer>
+#include <QWidget>
+#include <functional>
+#include <vector>
+
+// AnimationScheduler 类：统一驱动界面上的小动画（食物呼吸等），只为正在播放的动画唤醒事件循环
+// 每个动画登记自己的帧间隔与推进函数，推进函数返回这一帧需要重绘的区域（空区域表示画面没有变化）；
+// 调度器只用一个单次定时器，定在最早到期的活动动画上，多个同时到期的动画合并为一次 update(region)
+// 没有活动动画或被挂起（窗口隐藏、最小化、失去激活）时定时器停止，空闲时不再产生任何唤醒
+class AnimationScheduler {
+public:
+    // 推进一帧动画，返回需要重绘的区域（目标窗口坐标）
+    typedef std::function<QRegion()> Step;
+
+    // 构造函数：target 为接收重绘请求的窗口部件，定时器也挂在它下面
+    explicit AnimationScheduler(QWidget* target);
+
+    // 登记一个动画（初始为非活动状态），返回动画编号
+    int add(int intervalMs, Step step);
+
+    // 开始 / 停止播放某个动画（停止时保留相位，再次开始时从原处继续）
+    void setActive(int id, bool active);
+    bool isActive(int id) const { return animations[id].active; }
+
+    // 挂起 / 恢复所有动画（挂起期间活动状态照常记录，只是不再推进）
+    void setSuspended(bool suspended);
+    bool isSuspended() const { return suspended; }
+
+    // 当前是否有定时器在等待（即是否会唤醒事件循环）
+    bool isScheduled() const { return timer->isActive(); }
+
+private:
+    struct Animation {
+        int intervalMs;  // 帧间隔
+        Step step;       // 推进函数
+        bool active;     // 是否在播放
+        qint64 dueMs;    // 下一帧的到期时刻（相对 clock）
+    };
+
+    // 推进所有到期的活动动画并请求重绘
+    void onTimeout();
+
+    // 按最早到期的活动动画重新设置定时器（没有可推进的动画时停止定时器）
+    void reschedule();
+
+    QWidget* target;
+    QTimer* timer;                    // 单次定时器
+    QElapsedTimer clock;              // 到期时刻的时间基准
+    std::vector<Animation> animations;
+    bool suspended;
+};
+
+#endif // ANIMATIONSCHEDULER_H
\ No newline at end of file
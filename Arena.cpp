@@ -0,0 +1,173 @@
+#include "Arena.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// 每个线程的统计与复用的游戏状态，独占缓存行
+struct alignas(64) WorkerState {
+    std::vector<Arena::PolicyStats> stats;
+    std::vector<Autopilot> autopilots; // 每个策略一个，回路与搜索缓冲区跨局复用
+    MctsAgent mcts;
+    GameCore core;
+};
+
+// 把一局的结果混合为 64 位散列（splitmix64 的最终混合步骤）
+quint64 mix(quint64 x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+} // namespace
+
+void Arena::PolicyStats::merge(const PolicyStats& other) {
+    games += other.games;
+    totalScore += other.totalScore;
+    totalLength += other.totalLength;
+    totalTicks += other.totalTicks;
+    died += other.died;
+    stalled += other.stalled;
+    completed += other.completed;
+    if (other.minScore >= 0) {
+        minScore = minScore < 0 ? other.minScore : std::min(minScore, other.minScore);
+    }
+    maxScore = std::max(maxScore, other.maxScore);
+    checksum += other.checksum;
+    nanos += other.nanos;
+}
+
+quint64 Arena::seedFor(quint64 baseSeed, quint64 game) {
+    Random mixer(baseSeed ^ (game * 0x9E3779B97F4A7C15ULL));
+    return mixer.next();
+}
+
+const char* Arena::policyName(Policy policy) {
+    switch (policy) {
+        case GreedyPolicy: return "greedy";
+        case AStarPolicy:  return "astar";
+        case CyclePolicy:  return "cycle";
+        case MctsPolicy:   return "mcts";
+    }
+    return "?";
+}
+
+bool Arena::parsePolicy(const char* name, Policy& policy) {
+    for (Policy candidate : {GreedyPolicy, AStarPolicy, CyclePolicy, MctsPolicy}) {
+        if (std::strcmp(name, policyName(candidate)) == 0) {
+            policy = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+Arena::Outcome Arena::play(Policy policy, GameCore& core, Autopilot& autopilot, MctsAgent& mcts, quint64 seed,
+                           bool obstacleMap) {
+    core.reset(seed, obstacleMap);
+    if (policy == MctsPolicy) {
+        mcts.seed(seed);
+    } else if (policy != GreedyPolicy) {
+        const Autopilot::Strategy strategy = policy == CyclePolicy ? Autopilot::CycleStrategy : Autopilot::PathStrategy;
+        if (autopilot.getStrategy() != strategy) autopilot.setStrategy(strategy);
+    }
+    const quint64 stallTicks = static_cast<quint64>(core.getWidth()) * core.getHeight() * STALL_TICKS_PER_CELL;
+    int lastScore = core.getScore();
+    quint64 lastScoreTick = 0;
+    while (!core.isGameOver()) {
+        switch (policy) {
+            case GreedyPolicy: core.step(greedy(core)); break;
+            case MctsPolicy:   core.step(mcts.choose(core)); break;
+            default:           core.step(autopilot.choose(core)); break;
+        }
+        if (core.getScore() != lastScore) {
+            lastScore = core.getScore();
+            lastScoreTick = core.getTickCount();
+        } else if (core.getTickCount() - lastScoreTick > stallTicks) {
+            return Stalled;
+        }
+    }
+    return core.isBoardComplete() ? Completed : Died;
+}
+
+Arena::Report Arena::run(const Config& config, WorkStealingPool& pool) {
+    const int policyCount = static_cast<int>(config.policies.size());
+    std::vector<WorkerState> workers(pool.size());
+    for (WorkerState& worker : workers) {
+        worker.stats.assign(policyCount, PolicyStats());
+        worker.autopilots.assign(policyCount, Autopilot(config.width, config.height));
+        worker.core = GameCore(config.width, config.height);
+        MctsAgent::Config search;
+        search.budgetNanos = 0;
+        search.maxPlayouts = MCTS_PLAYOUTS;
+        worker.mcts.setConfig(search);
+    }
+
+    // 任务 k 为第 k / 策略数 局、第 k % 策略数 个策略
+    const auto begin = std::chrono::steady_clock::now();
+    pool.parallelFor(config.games * policyCount, config.grain, [&](int worker, quint64 first, quint64 last) {
+        WorkerState& state = workers[worker];
+        for (quint64 task = first; task < last; ++task) {
+            const quint64 game = task / policyCount;
+            const int p = static_cast<int>(task % policyCount);
+            const quint64 seed = seedFor(config.baseSeed, game);
+            const auto started = std::chrono::steady_clock::now();
+            const Outcome outcome = play(config.policies[p], state.core, state.autopilots[p], state.mcts, seed,
+                                         config.obstacleMap);
+            PolicyStats& stats = state.stats[p];
+            stats.nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+            const int score = state.core.getScore();
+            ++stats.games;
+            stats.totalScore += static_cast<quint64>(score);
+            stats.totalLength += static_cast<quint64>(state.core.getSnake().getLength());
+            stats.totalTicks += state.core.getTickCount();
+            if (outcome == Died) ++stats.died;
+            if (outcome == Stalled) ++stats.stalled;
+            if (outcome == Completed) ++stats.completed;
+            stats.minScore = stats.minScore < 0 ? score : std::min(stats.minScore, score);
+            stats.maxScore = std::max(stats.maxScore, score);
+            stats.checksum += mix(seed ^ mix(static_cast<quint64>(score) ^ (state.core.getTickCount() << 20)
+                                             ^ (static_cast<quint64>(outcome) << 62)));
+        }
+    });
+
+    Report report;
+    report.policies = config.policies;
+    report.stats.assign(policyCount, PolicyStats());
+    for (const WorkerState& worker : workers) {
+        for (int p = 0; p < policyCount; ++p) {
+            report.stats[p].merge(worker.stats[p]);
+        }
+    }
+    report.threads = pool.size();
+    report.steals = pool.getSteals();
+    report.wallNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+    return report;
+}
+
+Snake::Direction Arena::greedy(const GameCore& core) {
+    const Snake& snake = core.getSnake();
+    const QPoint head = snake.getHead();
+    const QPoint food = core.getFood().getPosition();
+    const Snake::Direction order[4] = {
+        food.x() > head.x() ? Snake::Right : Snake::Left,
+        food.y() > head.y() ? Snake::Down : Snake::Up,
+        food.x() > head.x() ? Snake::Left : Snake::Right,
+        food.y() > head.y() ? Snake::Up : Snake::Down,
+    };
+    for (Snake::Direction dir : order) {
+        if (Snake::isOpposite(dir, snake.getDirection())) continue;
+        QPoint next = head;
+        switch (dir) {
+            case Snake::Up:    next.ry() -= 1; break;
+            case Snake::Down:  next.ry() += 1; break;
+            case Snake::Left:  next.rx() -= 1; break;
+            case Snake::Right: next.rx() += 1; break;
+        }
+        if (snake.getOccupancy().contains(next) && !snake.isOccupied(next) && !core.isObstacle(next)) {
+            return dir;
+        }
+    }
+    return snake.getDirection();
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <QtGlobal>
+#include <vector>
+#include "Autopilot.h"
+#include "GameCore.h"
+#include "MctsAgent.h"
+#include "WorkStealingPool.h"
+
+// Arena 类：无界面批量对局（自我对弈锦标赛），在 WorkStealingPool 上并行运行，按策略汇总成绩
+// 对局直接调用 GameCore::step()，与 SnakeGame::update() 使用同一份游戏规则
+// 第 i 局的种子只由基准种子与 i 决定，各策略使用相同的种子；每个线程把结果累加到自己的统计中，
+// 结束后再合并。统计只由求和、最小 / 最大值与校验和组成，与合并顺序无关，
+// 因此除耗时外的报告与线程数、任务被哪个线程偷走都无关
+class Arena {
+public:
+    static constexpr int STALL_TICKS_PER_CELL = 4; // 连续这么多倍格子数的逻辑帧没有得分即判为打转并结束
+    static constexpr quint64 MCTS_PLAYOUTS = 64;   // MctsPolicy 每步的模拟次数（按次数而不是时间限制，结果可复现）
+
+    // 对局策略
+    enum Policy {
+        GreedyPolicy,  // 朝食物方向走，只避开会立即死亡的格子
+        AStarPolicy,   // Autopilot::PathStrategy
+        CyclePolicy,   // Autopilot::CycleStrategy
+        MctsPolicy     // MctsAgent，在对局所在的线程上单线程搜索
+    };
+
+    // 一局的结果
+    enum Outcome {
+        Died,          // 撞墙、撞到自己或障碍物
+        Stalled,       // 长时间吃不到食物，被判打转
+        Completed      // 填满整张地图
+    };
+
+    // 锦标赛配置
+    struct Config {
+        int width = 20;
+        int height = 20;
+        bool obstacleMap = false;
+        quint64 games = 1000;       // 每个策略的局数
+        quint64 baseSeed = 1;       // 基准种子
+        quint64 grain = 16;         // 每次从任务区间取出的局数
+        std::vector<Policy> policies;
+    };
+
+    // 一个策略的统计（所有字段都可按任意顺序合并）
+    struct PolicyStats {
+        quint64 games = 0;
+        quint64 totalScore = 0;
+        quint64 totalLength = 0;     // 结束时蛇长之和
+        quint64 totalTicks = 0;      // 存活逻辑帧数之和
+        quint64 died = 0;
+        quint64 stalled = 0;
+        quint64 completed = 0;
+        int minScore = -1;           // 尚无对局时为 -1
+        int maxScore = 0;
+        quint64 checksum = 0;        // 各局 (种子, 得分, 帧数, 结局) 散列之和，用于比对两次运行
+        qint64 nanos = 0;            // 各局耗时之和（线程时间，只用于计算每秒逻辑帧数）
+
+        // 合并另一份统计
+        void merge(const PolicyStats& other);
+    };
+
+    // 锦标赛结果
+    struct Report {
+        std::vector<Policy> policies;
+        std::vector<PolicyStats> stats; // 与 policies 一一对应
+        int threads = 0;
+        quint64 steals = 0;
+        qint64 wallNanos = 0;
+    };
+
+    // 第 game 局的种子（与 GameCore::reset() 搭配即可单独复现任意一局）
+    static quint64 seedFor(quint64 baseSeed, quint64 game);
+
+    // 策略名称（greedy / astar / cycle / mcts）与按名称查找，名称无效时返回 false
+    static const char* policyName(Policy policy);
+    static bool parsePolicy(const char* name, Policy& policy);
+
+    // 用 autopilot 或 mcts（由调用方复用，避免每局重新分配缓冲区）以 policy 玩完一局，写入 core 并返回结局
+    // MctsPolicy 使用 mcts 当前的搜索参数，推演种子在开局时设为 seed
+    static Outcome play(Policy policy, GameCore& core, Autopilot& autopilot, MctsAgent& mcts, quint64 seed, bool obstacleMap);
+
+    // 在 pool 上运行锦标赛
+    static Report run(const Config& config, WorkStealingPool& pool);
+
+private:
+    // GreedyPolicy 的决策
+    static Snake::Direction greedy(const GameCore& core);
+};
+
+#endif // ARENA_H
\ No newline at end of file
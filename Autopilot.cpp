@@ -0,0 +1,361 @@
+#include "Autopilot.h"
+#include <algorithm>
+#include <cstdlib>
+
+Autopilot::Autopilot(int width, int height)
+    : strategy(PathStrategy), width(0), height(0), core(nullptr), food(0), ringCapacity(0), ringHead(0),
+      ringLength(0), pendingGrow(false), behind(-1), epoch(0), useBoard(false), cycleChecked(false), cycleEngaged(false),
+      cycleSeed(0), cycleTick(0) {
+    resize(width, height);
+}
+
+void Autopilot::resize(int w, int h) {
+    width = w;
+    height = h;
+    const int cells = w * h;
+    ringCapacity = cells + 1;
+    ring.assign(ringCapacity, 0);
+    ringHead = 0;
+    ringLength = 0;
+    occupied.assign(cells, 0);
+    visited.assign(cells, 0);
+    epoch = 0;
+    cost.assign(cells, 0);
+    parent.assign(cells, 0);
+    heap.clear();
+    heap.reserve(static_cast<size_t>(cells) * 4 + 1);
+    queue.assign(cells, 0);
+    path.clear();
+    path.reserve(cells);
+    board.resize(w, h);
+    useBoard = BoardEngine::canFloodFill(w, h);
+}
+
+Snake::Direction Autopilot::choose(const GameCore& game) {
+    const Snake& snake = game.getSnake();
+    if (game.isGameOver() || !canDrive(game.getWidth(), game.getHeight())) return snake.getDirection();
+    if (game.getWidth() != width || game.getHeight() != height) {
+        resize(game.getWidth(), game.getHeight());
+    }
+    ++stats.decisions;
+    core = &game;
+    const QPoint foodPoint = game.getFood().getPosition();
+    food = foodPoint.y() * width + foodPoint.x();
+    if (strategy == CycleStrategy) {
+        Snake::Direction dir;
+        if (chooseOnCycle(game, dir)) return dir;
+    }
+    if (useBoard) {
+        board.loadObstacles(game);
+    }
+    loadSnake(game);
+    const int head = virtualHead();
+    behind = cellBehind(head, snake.getDirection());
+
+    // 1. 最短路径 + 尾部安全检查：模拟吃到食物之后蛇头还能到达蛇尾（或已填满地图）
+    if (findPath(food)) {
+        const int firstStep = path.front();
+        for (int cell : path) {
+            moveVirtual(cell);
+        }
+        const bool filled = ringLength + (pendingGrow ? 1 : 0) >= game.getFreeCells().size() + snake.getLength();
+        if (filled || tailDistance() >= 0) {
+            ++stats.pathMoves;
+            return directionTo(head, firstStep);
+        }
+    }
+
+    // 2. 跟随蛇尾：在走一步之后仍能到达蛇尾的方向中选离蛇尾最远的一个；
+    // 3. 都到不了蛇尾时选可达空间最大的方向
+    int candidates[4];
+    const int count = neighbors(head, candidates);
+    int bestTail = -1;
+    int bestTailCell = -1;
+    int bestSpace = -1;
+    int bestSpaceCell = -1;
+    for (int i = 0; i < count; ++i) {
+        loadSnake(game);
+        const int next = candidates[i];
+        if (next == behind || !enterable(next)) continue;
+        moveVirtual(next);
+        const int distance = tailDistance();
+        if (distance > bestTail) {
+            bestTail = distance;
+            bestTailCell = next;
+        }
+        if (bestTail < 0) {
+            const int space = reachableSpace();
+            if (space > bestSpace) {
+                bestSpace = space;
+                bestSpaceCell = next;
+            }
+        }
+    }
+    if (bestTailCell >= 0) {
+        ++stats.tailMoves;
+        return directionTo(head, bestTailCell);
+    }
+    if (bestSpaceCell >= 0) {
+        ++stats.spaceMoves;
+        return directionTo(head, bestSpaceCell);
+    }
+    ++stats.trappedMoves;
+    return snake.getDirection();
+}
+
+void Autopilot::setStrategy(Strategy s) {
+    strategy = s;
+    cycleChecked = false; // 下一次决策时重新构造回路
+    cycleEngaged = false;
+}
+
+bool Autopilot::chooseOnCycle(const GameCore& game, Snake::Direction& dir) {
+    const quint64 tick = game.getTickCount();
+    if (!cycleChecked || game.getSeed() != cycleSeed || (tick != cycleTick && tick != cycleTick + 1)) {
+        engageCycle(game);
+        cycleChecked = true;
+    }
+    cycleTick = tick;
+    if (!cycleEngaged) return false;
+
+    const Snake& snake = game.getSnake();
+    const int length = snake.getLength();
+    const int head = static_cast<int>(snake.cellAt(0));
+    const int tail = static_cast<int>(snake.cellAt(length - 1));
+    // 身体在回路上按顺序排列，蛇头前方到蛇尾之间的 tailGap - 1 个格子都是空的
+    const int tailGap = head == tail ? cycle.size() : cycle.distance(head, tail);
+    const int foodGap = cycle.distance(head, food);
+    const int needed = length + (snake.isGrowing() ? 1 : 0) + CYCLE_SHORTCUT_MARGIN;
+    int target = cycle.next(head);
+    int best = 1;
+    int next[4];
+    const int count = neighbors(head, next);
+    for (int i = 0; i < count; ++i) {
+        const int d = cycle.distance(head, next[i]);
+        if (d <= best || d > foodGap) continue;     // 不后退，也不越过食物
+        if (tailGap - d - 1 < needed) continue;     // 跳过之后前方空段不够长
+        best = d;
+        target = next[i];
+    }
+    if (best > 1) {
+        ++stats.shortcutMoves;
+    } else {
+        ++stats.cycleMoves;
+    }
+    dir = directionTo(head, target);
+    return true;
+}
+
+bool Autopilot::engageCycle(const GameCore& game) {
+    cycleSeed = game.getSeed();
+    cycleEngaged = false;
+    if (!cycle.build(game.getWidth(), game.getHeight(), game.getObstacleGrid())) return false;
+    const Snake& snake = game.getSnake();
+    const int length = snake.getLength();
+    const int head = static_cast<int>(snake.cellAt(0));
+    const int tail = static_cast<int>(snake.cellAt(length - 1));
+    for (int attempt = 0; attempt < 2; ++attempt, cycle.reverse()) {
+        // 从蛇尾到蛇头，各节在回路上的位置必须严格递增；只有一节时要求回路的下一步不是掉头
+        bool ordered = !Snake::isOpposite(directionTo(head, cycle.next(head)), snake.getDirection());
+        for (int i = length - 2; i >= 0 && ordered; --i) {
+            ordered = cycle.distance(tail, static_cast<int>(snake.cellAt(i)))
+                      > cycle.distance(tail, static_cast<int>(snake.cellAt(i + 1)));
+        }
+        if (ordered) {
+            cycleEngaged = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+void Autopilot::loadSnake(const GameCore& game) {
+    for (int i = 0; i < ringLength; ++i) {
+        const int cell = ring[(ringHead + i) % ringCapacity];
+        occupied[cell] = 0;
+        board.release(cell);
+    }
+    const Snake& snake = game.getSnake();
+    ringHead = 0;
+    ringLength = snake.getLength();
+    for (int i = 0; i < ringLength; ++i) {
+        const int cell = static_cast<int>(snake.cellAt(i));
+        ring[i] = cell;
+        occupied[cell] = 1;
+        board.occupy(cell);
+    }
+    pendingGrow = snake.isGrowing();
+}
+
+void Autopilot::moveVirtual(int cell) {
+    if (pendingGrow) {
+        pendingGrow = false;
+    } else {
+        occupied[virtualTail()] = 0;
+        board.release(virtualTail());
+        --ringLength;
+    }
+    ringHead = ringHead == 0 ? ringCapacity - 1 : ringHead - 1;
+    ring[ringHead] = cell;
+    ++ringLength;
+    occupied[cell] = 1;
+    board.occupy(cell);
+    if (cell == food) {
+        pendingGrow = true;
+    }
+}
+
+bool Autopilot::enterable(int cell) const {
+    if (core->isObstacle(QPoint(cell % width, cell / width))) return false;
+    return !occupied[cell] || (cell == virtualTail() && !pendingGrow && ringLength > 1);
+}
+
+void Autopilot::nextEpoch() {
+    if (++epoch == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        epoch = 1;
+    }
+}
+
+int Autopilot::neighbors(int cell, int out[4]) const {
+    const int x = cell % width;
+    const int y = cell / width;
+    int count = 0;
+    if (y > 0) out[count++] = cell - width;
+    if (y < height - 1) out[count++] = cell + width;
+    if (x > 0) out[count++] = cell - 1;
+    if (x < width - 1) out[count++] = cell + 1;
+    return count;
+}
+
+bool Autopilot::findPath(int goal) {
+    const int start = virtualHead();
+    const int goalX = goal % width;
+    const int goalY = goal / width;
+    auto estimate = [&](int cell) { return std::abs(cell % width - goalX) + std::abs(cell / width - goalY); };
+    auto after = [](const Node& a, const Node& b) { return a.f > b.f || (a.f == b.f && a.g < b.g); };
+
+    nextEpoch();
+    heap.clear();
+    visited[start] = epoch;
+    cost[start] = 0;
+    parent[start] = start;
+    heap.push_back(Node{estimate(start), 0, start});
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), after);
+        const Node node = heap.back();
+        heap.pop_back();
+        if (node.g != cost[node.cell]) continue; // 已有更短的路径，过期的堆节点
+        if (node.cell == goal) {
+            path.clear();
+            for (int cell = goal; cell != start; cell = parent[cell]) {
+                path.push_back(cell);
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+        int next[4];
+        const int count = neighbors(node.cell, next);
+        for (int i = 0; i < count; ++i) {
+            const int cell = next[i];
+            if (!enterable(cell) || (node.cell == start && cell == behind)) continue;
+            const int g = node.g + 1;
+            if (visited[cell] == epoch && cost[cell] <= g) continue;
+            visited[cell] = epoch;
+            cost[cell] = g;
+            parent[cell] = node.cell;
+            heap.push_back(Node{g + estimate(cell), g, cell});
+            std::push_heap(heap.begin(), heap.end(), after);
+        }
+    }
+    return false;
+}
+
+int Autopilot::tailDistance() {
+    if (ringLength <= 1) return 0;
+    const int start = virtualHead();
+    const int tail = virtualTail();
+    if (useBoard) {
+        // 位棋盘每扩展一轮前进一步，蛇尾第一次进入可达区域时的轮数就是距离
+        board.beginFlood(start);
+        if (!pendingGrow) board.allow(tail);
+        for (int distance = 1; board.grow(); ++distance) {
+            if (board.reached(tail)) return distance;
+            // 刚吃到食物时蛇尾下一步不动，紧挨着的蛇尾不能直接进入，从第二步起才可以
+            board.allow(tail);
+        }
+        return -1;
+    }
+    nextEpoch();
+    int front = 0;
+    int back = 0;
+    visited[start] = epoch;
+    cost[start] = 0;
+    queue[back++] = start;
+    while (front < back) {
+        const int cell = queue[front++];
+        int next[4];
+        const int count = neighbors(cell, next);
+        for (int i = 0; i < count; ++i) {
+            const int n = next[i];
+            if (visited[n] == epoch) continue;
+            if (n == tail) {
+                // 刚吃到食物时蛇尾下一步不动，紧挨着的蛇尾不能直接进入
+                if (cost[cell] + 1 == 1 && pendingGrow) continue;
+                return cost[cell] + 1;
+            }
+            if (occupied[n] || core->isObstacle(QPoint(n % width, n / width))) continue;
+            visited[n] = epoch;
+            cost[n] = cost[cell] + 1;
+            queue[back++] = n;
+        }
+    }
+    return -1;
+}
+
+int Autopilot::reachableSpace() {
+    const int start = virtualHead();
+    if (useBoard) {
+        board.beginFlood(start);
+        if (!pendingGrow && ringLength > 1) board.allow(virtualTail()); // 同 enterable()：下一步就会移走的蛇尾
+        while (board.grow()) {
+        }
+        return board.reachedCount();
+    }
+    nextEpoch();
+    int front = 0;
+    int back = 0;
+    visited[start] = epoch;
+    queue[back++] = start;
+    while (front < back) {
+        const int cell = queue[front++];
+        int next[4];
+        const int count = neighbors(cell, next);
+        for (int i = 0; i < count; ++i) {
+            const int n = next[i];
+            if (visited[n] == epoch || !enterable(n)) continue;
+            visited[n] = epoch;
+            queue[back++] = n;
+        }
+    }
+    return back - 1;
+}
+
+int Autopilot::cellBehind(int cell, Snake::Direction dir) const {
+    const int x = cell % width;
+    const int y = cell / width;
+    switch (dir) {
+        case Snake::Up:    return y < height - 1 ? cell + width : -1;
+        case Snake::Down:  return y > 0 ? cell - width : -1;
+        case Snake::Left:  return x < width - 1 ? cell + 1 : -1;
+        case Snake::Right: return x > 0 ? cell - 1 : -1;
+    }
+    return -1;
+}
+
+Snake::Direction Autopilot::directionTo(int from, int to) const {
+    if (to == from - width) return Snake::Up;
+    if (to == from + width) return Snake::Down;
+    if (to == from - 1) return Snake::Left;
+    return Snake::Right;
+}
\ No newline at end of file
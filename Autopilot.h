@@ -0,0 +1,153 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include <QtGlobal>
+#include <vector>
+#include "BoardEngine.h"
+#include "GameCore.h"
+#include "HamiltonCycle.h"
+
+// Autopilot 类：自动驾驶，每个逻辑帧根据当前局面选择一个方向
+//   1. 在占用位图上用 A*（曼哈顿距离）找到蛇头到食物的最短路径；
+//   2. 在内部的“虚拟蛇”上模拟沿该路径吃到食物，之后蛇头仍能到达自己的蛇尾才采用这条路径（尾部安全检查）；
+//   3. 否则在相邻的安全格子中选择离蛇尾最远、但仍能到达蛇尾的一步（跟着尾巴绕圈，等待更好的时机）；
+//      所有方向都到不了蛇尾时，选择可达空间最大的一步
+// 搜索用到的队列、堆、标记与虚拟蛇都在 resize() 时按地图格子数一次分配，choose() 本身不分配内存；
+// 标记数组用递增的轮次号区分不同搜索，不需要每次清零
+// 不超过 BoardEngine::MAX_FLOOD_CELLS 的地图上，蛇尾距离与可达空间改用位棋盘逐轮扩展（虚拟蛇同步标记在
+// BoardEngine 中），一次处理 64 个格子；更大的地图扩展一轮的整字运算太多，仍用逐格 BFS
+// CycleStrategy 改为沿预先构造的哈密顿回路行走，每帧只查表（O(1)），保证填满整张地图；
+// 蛇还短时抄近路：只走向回路上更靠前、且不越过食物的相邻格子，并保证跳过之后蛇头前方直到蛇尾的空段
+// 仍比整条蛇长出 CYCLE_SHORTCUT_MARGIN：空段只在蛇增长时缩短，蛇尾走完整条蛇、跳过的格子全部回到空段之前，
+// 蛇头要追上蛇尾需要先连续吃到比蛇还多的食物；蛇长过半后不再抄近路，纯回路行走必然填满地图
+// 地图上构造不出回路（有障碍物、两边都是奇数），或开启时蛇身不在回路顺序上时，退回 A* 策略
+class Autopilot {
+public:
+    static constexpr int MAX_CELLS = 512 * 512; // 允许自动驾驶的最大格子数（更大的地图缓冲区过大，不做决策）
+    static constexpr int CYCLE_SHORTCUT_MARGIN = 4; // 抄近路后蛇头前方空段至少比蛇长出的格子数
+
+    // 决策策略
+    enum Strategy {
+        PathStrategy,  // A* 寻路 + 蛇尾安全检查
+        CycleStrategy  // 哈密顿回路 + 安全的近路
+    };
+
+    // 地图是否小到可以自动驾驶
+    static bool canDrive(int width, int height) { return width * height <= MAX_CELLS; }
+
+    // 决策统计
+    struct Stats {
+        quint64 decisions = 0;     // 决策次数
+        quint64 pathMoves = 0;     // 沿通过尾部安全检查的最短路径前进的次数
+        quint64 tailMoves = 0;     // 改为跟随蛇尾的次数
+        quint64 spaceMoves = 0;    // 到不了蛇尾、只能选可达空间最大一步的次数
+        quint64 trappedMoves = 0;  // 没有任何不立即死亡的方向的次数
+        quint64 cycleMoves = 0;    // 沿哈密顿回路前进的次数
+        quint64 shortcutMoves = 0; // 在回路上抄近路的次数
+    };
+
+    // 构造函数：按地图尺寸预先分配搜索缓冲区
+    explicit Autopilot(int width = 20, int height = 20);
+
+    // 按新的地图尺寸重新分配缓冲区（choose() 遇到不同尺寸时自动调用）
+    void resize(int width, int height);
+
+    // 设置 / 获取决策策略（默认 PathStrategy）
+    void setStrategy(Strategy strategy);
+    Strategy getStrategy() const { return strategy; }
+
+    // 当前对局是否正沿哈密顿回路行走（CycleStrategy 下构造不出回路时为 false）
+    bool isOnCycle() const { return cycleEngaged; }
+
+    // 为当前局面选择下一帧的方向（游戏已结束或地图超过 MAX_CELLS 时返回当前方向）
+    Snake::Direction choose(const GameCore& core);
+
+    // 决策统计（从构造或 resetStats() 起累计）
+    const Stats& getStats() const { return stats; }
+    void resetStats() { stats = Stats(); }
+
+private:
+    // A* 堆中的节点：f = g + h，f 相同时优先展开 g 大的（更接近目标）
+    struct Node {
+        int f;
+        int g;
+        int cell;
+    };
+
+    // CycleStrategy：沿回路（或近路）选择方向，回路不可用时返回 false
+    bool chooseOnCycle(const GameCore& game, Snake::Direction& dir);
+
+    // 为 game 构造回路并检查蛇身是否按回路顺序排列（必要时反转回路方向），成功时返回 true
+    bool engageCycle(const GameCore& game);
+
+    // 把 core 中的蛇载入虚拟蛇（先清除上一次的虚拟蛇标记）
+    void loadSnake(const GameCore& core);
+
+    // 虚拟蛇向 cell 移动一步（规则同 Snake::move()：先移走尾部，吃到食物后下一步不移走尾部）
+    void moveVirtual(int cell);
+
+    // 虚拟蛇的蛇头 / 蛇尾格子
+    int virtualHead() const { return ring[ringHead]; }
+    int virtualTail() const { return ring[(ringHead + ringLength - 1) % ringCapacity]; }
+
+    // 格子是否可以进入：不是障碍物，且不被虚拟蛇占用（下一步就会移走的蛇尾除外）
+    bool enterable(int cell) const;
+
+    // 开始新一轮搜索（轮次号回绕时清零标记数组）
+    void nextEpoch();
+
+    // 取 cell 的相邻格子，返回个数（越界的方向省略）
+    int neighbors(int cell, int out[4]) const;
+
+    // A* 搜索虚拟蛇头到 goal 的最短路径，找到时把路径（不含起点）写入 path 并返回 true
+    bool findPath(int goal);
+
+    // 虚拟蛇头到虚拟蛇尾的最短距离（到不了时返回 -1）
+    int tailDistance();
+
+    // 从虚拟蛇头出发可到达的空闲格子数
+    int reachableSpace();
+
+    // cell 在 dir 反方向上的相邻格子（越界时为 -1）
+    int cellBehind(int cell, Snake::Direction dir) const;
+
+    // 从 from 走到相邻格子 to 的方向
+    Snake::Direction directionTo(int from, int to) const;
+
+    Strategy strategy;
+    int width;
+    int height;
+    const GameCore* core;          // 当前决策的局面（只在 choose() 期间有效）
+    int food;                      // 当前食物格子
+
+    // 虚拟蛇：环形缓冲区（蛇头在 ringHead，向下标递增方向排列）+ 占用标记
+    std::vector<int> ring;
+    int ringCapacity;
+    int ringHead;
+    int ringLength;
+    bool pendingGrow;
+    std::vector<quint8> occupied;
+    int behind;                    // 蛇头正后方的格子：只有一节时它是空的，但第一步不能掉头走进去
+
+    // 搜索缓冲区
+    std::vector<quint32> visited;  // visited[cell] == epoch 表示本轮已访问
+    quint32 epoch;
+    std::vector<int> cost;         // 本轮的 g 值 / BFS 距离
+    std::vector<int> parent;       // 本轮的前驱格子
+    std::vector<Node> heap;        // A* 开放列表（容量为 4 倍格子数，足以容纳所有松弛）
+    std::vector<int> queue;        // BFS 队列
+    std::vector<int> path;         // 最近一次 findPath() 的路径
+    BoardEngine board;             // 位棋盘：障碍物 + 虚拟蛇的占用标记（与 occupied 同步维护）
+    bool useBoard;                 // 当前地图是否用位棋盘计算蛇尾距离与可达空间
+
+    // 哈密顿回路：对局（种子）改变或决策的逻辑帧不连续时重新构造并检查蛇身
+    HamiltonCycle cycle;
+    bool cycleChecked;             // 是否已为当前对局构造并检查过回路
+    bool cycleEngaged;             // 本局是否沿回路行走
+    quint64 cycleSeed;             // 回路所属对局的种子
+    quint64 cycleTick;             // 上一次决策时的逻辑帧号
+
+    Stats stats;
+};
+
+#endif // AUTOPILOT_H
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "BatchEnv.h"
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// 第一阶段的内核：方向、新蛇头位置与撞墙检测，每局互不相关且循环体没有分支
+// 所有指针都标记为 __restrict：动作是 qint8 数组，不标记时编译器必须假设它可能与 qint32 输出重叠，
+// 只能逐项插入运行时重叠检查（超过上限后放弃向量化）
+void advanceHeads(int n, int width, int height, const qint8* __restrict actions, qint32* __restrict dirs,
+                  const qint32* __restrict hx, const qint32* __restrict hy, qint32* __restrict nx,
+                  qint32* __restrict ny, qint32* __restrict nc, quint8* __restrict hits) {
+    // 方向编码 Up=0, Down=1, Left=2, Right=3，两方向相反当且仅当异或结果为 1
+    for (int i = 0; i < n; ++i) {
+        const qint32 current = dirs[i];
+        const qint32 action = actions[i];
+        const qint32 wanted = action < 0 ? current : action;
+        const qint32 dir = (wanted ^ current) == 1 ? current : wanted;
+        dirs[i] = dir;
+        const qint32 x = hx[i] + (dir == 3) - (dir == 2);
+        const qint32 y = hy[i] + (dir == 1) - (dir == 0);
+        nx[i] = x;
+        ny[i] = y;
+        const qint32 off = (static_cast<quint32>(x) >= static_cast<quint32>(width))
+                         | (static_cast<quint32>(y) >= static_cast<quint32>(height));
+        nc[i] = off ? 0 : y * width + x;
+        hits[i] = static_cast<quint8>(off ? GameCore::HitWall : GameCore::Moved);
+    }
+}
+
+// 障碍物检测：每局从自己的障碍物位图中取一个字（间接寻址，只有支持 gather 的指令集才能向量化），同样没有分支
+// 障碍物位图不随蛇尾移动而变化，因此与蛇尾、占用位图的更新无关
+void markObstacleHits(int n, int wordsPerBoard, const quint64* __restrict obstacles, const qint32* __restrict nc,
+                      quint8* __restrict hits) {
+    for (int i = 0; i < n; ++i) {
+        const qint32 cell = nc[i];
+        const quint64 word = obstacles[static_cast<size_t>(i) * wordsPerBoard + (cell >> 6)];
+        const bool blocked = ((word >> (cell & 63)) & 1u) != 0 && hits[i] == GameCore::Moved;
+        hits[i] = blocked ? static_cast<quint8>(GameCore::HitObstacle) : hits[i];
+    }
+}
+
+} // namespace
+
+BatchEnv::BatchEnv(int count, int width, int height, bool obstacleMap, quint64 baseSeed)
+    : valid(canSimulate(width, height)), count(valid ? count : 0),
+      gridWidth(valid ? width : GameCore::MIN_SIZE), gridHeight(valid ? height : GameCore::MIN_SIZE),
+      cellCount(gridWidth * gridHeight), wordsPerBoard((cellCount + 63) / 64), ringCapacity(cellCount + 1),
+      obstacleMap(obstacleMap), baseSeed(baseSeed),
+      headX(this->count), headY(this->count), directions(this->count), lengths(this->count),
+      ringHeads(this->count), growFlags(this->count), foods(this->count), scores(this->count),
+      finalScores(this->count), freeSizes(this->count), episodes(this->count), rngs(this->count),
+      lastResults(this->count, GameCore::Moved),
+      rings(static_cast<size_t>(this->count) * ringCapacity),
+      occupancy(static_cast<size_t>(this->count) * wordsPerBoard),
+      obstacles(static_cast<size_t>(this->count) * wordsPerBoard),
+      freeCells(static_cast<size_t>(this->count) * cellCount),
+      freePositions(static_cast<size_t>(this->count) * cellCount),
+      nextX(this->count), nextY(this->count), nextCells(this->count), hits(this->count),
+      scratch(gridWidth, gridHeight) {
+    if (!valid) {
+        qDebug() << "Unsupported BatchEnv board size:" << width << "x" << height;
+    }
+    for (int i = 0; i < this->count; ++i) {
+        reset(i);
+    }
+}
+
+bool BatchEnv::canSimulate(int width, int height) {
+    if (width < GameCore::MIN_SIZE || width > GameCore::MAX_SIZE) return false;
+    if (height < GameCore::MIN_SIZE || height > GameCore::MAX_SIZE) return false;
+    return static_cast<qint64>(width) * height <= FreeCellSet::DENSE_LIMIT;
+}
+
+quint64 BatchEnv::seedFor(quint64 baseSeed, int game, quint64 episode) {
+    // 将 (基准种子, 局号, 开局次数) 混合为一个 64 位种子
+    Random mixer(baseSeed ^ (static_cast<quint64>(game) << 32) ^ (episode * 0x9E3779B97F4A7C15ULL));
+    return mixer.next();
+}
+
+void BatchEnv::reset(int game) {
+    // 用 GameCore 生成开局，再拷贝进结构数组，保证与单独运行的 GameCore 完全一致
+    scratch.reset(seedFor(baseSeed, game, episodes[game]), obstacleMap);
+    const Snake& snake = scratch.getSnake();
+
+    headX[game] = snake.getHead().x();
+    headY[game] = snake.getHead().y();
+    directions[game] = snake.getDirection();
+    lengths[game] = snake.getLength();
+    growFlags[game] = 0;
+    scores[game] = 0;
+    rngs[game] = scratch.getRandom();
+
+    const QPoint foodPos = scratch.getFood().getPosition();
+    foods[game] = scratch.isGameOver() ? -1 : foodPos.y() * gridWidth + foodPos.x();
+
+    qint32* ring = &rings[static_cast<size_t>(game) * ringCapacity];
+    quint64* occ = &occupancy[static_cast<size_t>(game) * wordsPerBoard];
+    quint64* obs = &obstacles[static_cast<size_t>(game) * wordsPerBoard];
+    std::fill(occ, occ + wordsPerBoard, 0);
+    ringHeads[game] = 0;
+    int k = 0;
+    for (const QPoint& part : snake.getBody()) {
+        const int cell = part.y() * gridWidth + part.x();
+        ring[k++] = cell;
+        setBit(occ, cell);
+    }
+    std::fill(obs, obs + wordsPerBoard, 0);
+    for (const QPoint& obstacle : scratch.getObstacles()) {
+        setBit(obs, obstacle.y() * gridWidth + obstacle.x());
+    }
+
+    const FreeCellSet& free = scratch.getFreeCells();
+    qint32* dense = &freeCells[static_cast<size_t>(game) * cellCount];
+    qint32* positions = &freePositions[static_cast<size_t>(game) * cellCount];
+    std::fill(positions, positions + cellCount, -1);
+    freeSizes[game] = free.size();
+    for (int i = 0; i < free.size(); ++i) {
+        const QPoint cell = free.at(i);
+        dense[i] = cell.y() * gridWidth + cell.x();
+        positions[dense[i]] = i;
+    }
+}
+
+void BatchEnv::freeInsert(int game, int cell) {
+    qint32* dense = &freeCells[static_cast<size_t>(game) * cellCount];
+    qint32* positions = &freePositions[static_cast<size_t>(game) * cellCount];
+    if (positions[cell] >= 0) return;
+    positions[cell] = freeSizes[game];
+    dense[freeSizes[game]++] = cell;
+}
+
+void BatchEnv::freeRemove(int game, int cell) {
+    qint32* dense = &freeCells[static_cast<size_t>(game) * cellCount];
+    qint32* positions = &freePositions[static_cast<size_t>(game) * cellCount];
+    const int pos = positions[cell];
+    if (pos < 0) return;
+    const int last = dense[--freeSizes[game]];
+    dense[pos] = last;
+    positions[last] = pos;
+    positions[cell] = -1;
+}
+
+void BatchEnv::step(const qint8* actions) {
+    const int n = count;
+    const int width = gridWidth;
+    const int height = gridHeight;
+
+    // 第一阶段：方向、新蛇头位置、撞墙与撞障碍物，都不依赖蛇尾的移动，整批无分支地算完
+    advanceHeads(n, width, height, actions, directions.data(), headX.data(), headY.data(), nextX.data(),
+                 nextY.data(), nextCells.data(), hits.data());
+    markObstacleHits(n, wordsPerBoard, obstacles.data(), nextCells.data(), hits.data());
+
+    // 第二阶段：逐局处理蛇尾、占用位图、空闲格子与食物（顺序与 GameCore::step() 相同）
+    for (int i = 0; i < n; ++i) {
+        qint32* ring = &rings[static_cast<size_t>(i) * ringCapacity];
+        quint64* occ = &occupancy[static_cast<size_t>(i) * wordsPerBoard];
+
+        // 移除蛇尾（增长时保留）
+        int vacated = -1;
+        if (growFlags[i]) {
+            growFlags[i] = 0;
+        } else {
+            int tailPos = ringHeads[i] + lengths[i] - 1;
+            if (tailPos >= ringCapacity) tailPos -= ringCapacity;
+            vacated = ring[tailPos];
+            clearBit(occ, vacated);
+            --lengths[i];
+        }
+
+        // 插入新蛇头
+        const bool off = hits[i] == GameCore::HitWall;
+        const int cell = nextCells[i];
+        const bool selfHit = !off && testBit(occ, cell);
+        ringHeads[i] = ringHeads[i] == 0 ? ringCapacity - 1 : ringHeads[i] - 1;
+        ring[ringHeads[i]] = cell;
+        ++lengths[i];
+        headX[i] = nextX[i];
+        headY[i] = nextY[i];
+        if (!off) setBit(occ, cell);
+
+        // 维护空闲格子集合
+        if (vacated >= 0) freeInsert(i, vacated);
+        if (!off) freeRemove(i, cell);
+
+        // 碰撞检测：墙与障碍物已在第一阶段得出（蛇身不会与障碍物重叠，与 GameCore 的判断顺序无关），
+        // 这里只剩依赖蛇尾移动的自身碰撞，然后处理食物
+        quint8 result = hits[i];
+        if (result == GameCore::Moved && selfHit) {
+            result = GameCore::HitSelf;
+        } else if (result == GameCore::Moved && cell == foods[i]) {
+            growFlags[i] = 1;
+            scores[i] += 10;
+            if (freeSizes[i] == 0) {
+                foods[i] = -1;
+                result = GameCore::BoardComplete;
+            } else {
+                const qint32* dense = &freeCells[static_cast<size_t>(i) * cellCount];
+                foods[i] = dense[rngs[i].bounded(freeSizes[i])];
+                result = GameCore::AteFood;
+            }
+        }
+        lastResults[i] = result;
+
+        // 结束的对局自动重开
+        if (result != GameCore::Moved && result != GameCore::AteFood) {
+            finalScores[i] = scores[i];
+            ++episodes[i];
+            reset(i);
+        }
+    }
+}
+
+QPoint BatchEnv::food(int game) const {
+    const int cell = foods[game];
+    return cell < 0 ? QPoint(-1, -1) : QPoint(cell % gridWidth, cell / gridWidth);
+}
+
+bool BatchEnv::isOccupied(int game, const QPoint& cell) const {
+    if (cell.x() < 0 || cell.x() >= gridWidth || cell.y() < 0 || cell.y() >= gridHeight) return false;
+    return testBit(&occupancy[static_cast<size_t>(game) * wordsPerBoard], cell.y() * gridWidth + cell.x());
+}
+
+bool BatchEnv::isObstacle(int game, const QPoint& cell) const {
+    if (cell.x() < 0 || cell.x() >= gridWidth || cell.y() < 0 || cell.y() >= gridHeight) return false;
+    return testBit(&obstacles[static_cast<size_t>(game) * wordsPerBoard], cell.y() * gridWidth + cell.x());
+}
@@ -0,0 +1,107 @@
+#ifndef BATCHENV_H
+#define BATCHENV_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <vector>
+#include "GameCore.h"
+#include "Random.h"
+
+// BatchEnv 类：以结构数组（SoA）形式同时保存 N 局独立的游戏，一次调用推进全部 N 局
+// 蛇头坐标、方向、长度、食物格子、占用位图等各自存放在连续数组中；蛇身是定长环形缓冲区，推进时不分配内存
+// 每局的规则与 GameCore::step() 完全一致（包括随机数的消耗顺序），结束的对局会自动以新种子重开
+// 空闲格子数组与 FreeCellSet 的稠密模式一一对应，因此地图格子数不能超过 FreeCellSet::DENSE_LIMIT；
+// 边长还必须在 GameCore::MIN_SIZE..MAX_SIZE 之内（与 SnakeGame 允许的地图相同），否则构造出的对象无效
+class BatchEnv {
+public:
+    // 构造函数：count 局游戏，地图 width x height，obstacleMap 为 true 时使用障碍物地图
+    // 尺寸不受支持（见 canSimulate()）时不创建任何对局，isValid() 为 false
+    BatchEnv(int count, int width = 20, int height = 20, bool obstacleMap = false, quint64 baseSeed = 1);
+
+    // 该尺寸能否批量模拟：边长在 GameCore::MIN_SIZE..MAX_SIZE 之内，且格子数不超过 FreeCellSet::DENSE_LIMIT
+    static bool canSimulate(int width, int height);
+
+    // 构造时尺寸是否受支持（无效时 size() 为 0，step() 不做任何事）
+    bool isValid() const { return valid; }
+
+    // 推进全部对局一个逻辑帧
+    // actions[i] 为第 i 局的动作：0..3 对应 Snake::Direction，负数表示保持当前方向
+    void step(const qint8* actions);
+
+    // 以第 episode 局的种子重开第 game 局
+    void reset(int game);
+
+    // 第 game 局第 episode 次开局使用的种子（与 GameCore::reset() 搭配即可单独复现任意一局）
+    static quint64 seedFor(quint64 baseSeed, int game, quint64 episode);
+
+    // 对局数量与地图尺寸
+    int size() const { return count; }
+    int getWidth() const { return gridWidth; }
+    int getHeight() const { return gridHeight; }
+
+    // 最近一次 step() 中每局的结果（GameCore::StepResult）；结束的对局此时已自动重开
+    const quint8* results() const { return lastResults.data(); }
+
+    // 最近一次结束时的最终得分（仅当 results()[game] 为结束结果时有意义）
+    int finalScore(int game) const { return finalScores[game]; }
+
+    // 单局状态查询
+    QPoint head(int game) const { return QPoint(headX[game], headY[game]); }
+    Snake::Direction direction(int game) const { return static_cast<Snake::Direction>(directions[game]); }
+    int length(int game) const { return lengths[game]; }
+    int score(int game) const { return scores[game]; }
+    QPoint food(int game) const;
+    quint64 episode(int game) const { return episodes[game]; }
+    bool isOccupied(int game, const QPoint& cell) const;
+    bool isObstacle(int game, const QPoint& cell) const;
+
+private:
+    // 位图操作（cell 为 y * width + x）
+    static bool testBit(const quint64* words, int cell) { return (words[cell >> 6] >> (cell & 63)) & 1u; }
+    static void setBit(quint64* words, int cell) { words[cell >> 6] |= quint64(1) << (cell & 63); }
+    static void clearBit(quint64* words, int cell) { words[cell >> 6] &= ~(quint64(1) << (cell & 63)); }
+
+    // 空闲格子集合操作（与 FreeCellSet 的顺序语义一致）
+    void freeInsert(int game, int cell);
+    void freeRemove(int game, int cell);
+
+    bool valid;                        // 构造时尺寸是否受支持
+    int count;                         // 对局数量
+    int gridWidth;                     // 地图宽度
+    int gridHeight;                    // 地图高度
+    int cellCount;                     // 每局格子总数
+    int wordsPerBoard;                 // 每局位图占用的 64 位字数
+    int ringCapacity;                  // 每局蛇身环形缓冲区容量
+    bool obstacleMap;                  // 是否使用障碍物地图
+    quint64 baseSeed;                  // 种子序列的基准
+
+    // 每局一项的状态数组
+    std::vector<qint32> headX, headY;  // 蛇头坐标
+    std::vector<qint32> directions;    // 当前方向（Snake::Direction）
+    std::vector<qint32> lengths;       // 蛇身长度
+    std::vector<qint32> ringHeads;     // 蛇头在环形缓冲区中的位置
+    std::vector<quint8> growFlags;     // 下一次移动是否增长
+    std::vector<qint32> foods;         // 食物格子编号（-1 表示没有食物）
+    std::vector<qint32> scores;        // 当前得分
+    std::vector<qint32> finalScores;   // 上一次结束时的得分
+    std::vector<qint32> freeSizes;     // 空闲格子数量
+    std::vector<quint64> episodes;     // 已开局次数
+    std::vector<Random> rngs;          // 每局的随机数生成器
+    std::vector<quint8> lastResults;   // 最近一次推进的结果
+
+    // 每局一段的大块数据（按局连续存放）
+    std::vector<qint32> rings;         // 蛇身环形缓冲区（格子编号），每局 ringCapacity 项
+    std::vector<quint64> occupancy;    // 蛇身占用位图，每局 wordsPerBoard 项
+    std::vector<quint64> obstacles;    // 障碍物位图，每局 wordsPerBoard 项
+    std::vector<qint32> freeCells;     // 空闲格子稠密数组，每局 cellCount 项
+    std::vector<qint32> freePositions; // 空闲格子位置索引，每局 cellCount 项
+
+    // 第一阶段（无分支）计算出的中间结果
+    std::vector<qint32> nextX, nextY;  // 新蛇头坐标
+    std::vector<qint32> nextCells;     // 新蛇头格子编号（越界时为 0）
+    std::vector<quint8> hits;          // 撞墙 / 撞障碍物的结果（GameCore::StepResult，否则为 Moved）
+
+    GameCore scratch;                  // 用于生成初始局面的临时核心（保证开局与 GameCore 完全一致）
+};
+
+#endif // BATCHENV_H
@@ -0,0 +1,225 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <QtAlgorithms>
+#include <QtGlobal>
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+// 位棋盘：把地图按行优先（编号 = y * width + x）压成若干 64 位字，每格 1 bit
+// 邻居扩展与洪水填充都是整字的移位、与、或运算，一次处理 64 个格子
+// Board<W, H> 在编译期确定字数与边界掩码，循环可被完全展开；GenericBoard 在运行时确定尺寸
+// 两者接口一致，算法共用 bitboard 命名空间中的函数模板：字数与宽度以 std::integral_constant 传入时
+// 每个实例化都按常量编译（移位量、循环次数全部确定），以 int 传入时即为通用的运行时版本
+
+namespace bitboard {
+
+// out = in 整体左移 n 位（编号增大方向），多出的高位丢弃
+template <typename Words, typename Shift>
+inline void shiftUp(const quint64* in, quint64* out, Words words, Shift n) {
+    const int wordShift = n >> 6;
+    const int bitShift = n & 63;
+    for (int i = words - 1; i >= 0; --i) {
+        const int src = i - wordShift;
+        quint64 value = src >= 0 ? in[src] << bitShift : 0;
+        if (bitShift != 0 && src - 1 >= 0) value |= in[src - 1] >> (64 - bitShift);
+        out[i] = value;
+    }
+}
+
+// out = in 整体右移 n 位（编号减小方向）
+template <typename Words, typename Shift>
+inline void shiftDown(const quint64* in, quint64* out, Words words, Shift n) {
+    const int wordShift = n >> 6;
+    const int bitShift = n & 63;
+    for (int i = 0; i < words; ++i) {
+        const int src = i + wordShift;
+        quint64 value = src < words ? in[src] >> bitShift : 0;
+        if (bitShift != 0 && src + 1 < words) value |= in[src + 1] << (64 - bitShift);
+        out[i] = value;
+    }
+}
+
+// 生成各类掩码：有效格子、第一列以外的格子、最后一列以外的格子（可在编译期求值）
+constexpr void buildMasks(int width, int height, quint64* valid, quint64* notFirstColumn, quint64* notLastColumn) {
+    const int words = (width * height + 63) / 64;
+    for (int i = 0; i < words; ++i) {
+        valid[i] = 0;
+        notFirstColumn[i] = 0;
+        notLastColumn[i] = 0;
+    }
+    for (int cell = 0; cell < width * height; ++cell) {
+        const quint64 bit = quint64(1) << (cell & 63);
+        valid[cell >> 6] |= bit;
+        if (cell % width != 0) notFirstColumn[cell >> 6] |= bit;
+        if (cell % width != width - 1) notLastColumn[cell >> 6] |= bit;
+    }
+}
+
+// 当前区域 reach 向四个方向各扩展一格后与 passable 取交集（结果写回 reach），返回 reach 是否变化
+// 左右移位后去掉跨行的位，上下移位一整行；scratch 至少需要 2 * words 个字
+// 每一轮恰好前进一步，因此目标格子第一次出现在 reach 中的轮数就是它的最短距离
+template <typename Words, typename Width>
+inline bool grow(quint64* reach, const quint64* passable, const quint64* notFirstColumn,
+                 const quint64* notLastColumn, quint64* scratch, Words words, Width width) {
+    quint64* grown = scratch;
+    quint64* shifted = scratch + words;
+    shiftUp(reach, shifted, words, std::integral_constant<int, 1>());
+    for (int i = 0; i < words; ++i) grown[i] = reach[i] | (shifted[i] & notFirstColumn[i]);
+    shiftDown(reach, shifted, words, std::integral_constant<int, 1>());
+    for (int i = 0; i < words; ++i) grown[i] |= shifted[i] & notLastColumn[i];
+    shiftUp(reach, shifted, words, width);
+    for (int i = 0; i < words; ++i) grown[i] |= shifted[i];
+    shiftDown(reach, shifted, words, width);
+    for (int i = 0; i < words; ++i) grown[i] |= shifted[i];
+    bool changed = false;
+    for (int i = 0; i < words; ++i) {
+        const quint64 next = grown[i] & passable[i];
+        changed |= next != reach[i];
+        reach[i] = next;
+    }
+    return changed;
+}
+
+// 从 reach 出发在 passable 内做洪水填充（结果写回 reach），scratch 至少需要 2 * words 个字
+// 每轮把当前区域向四个方向各扩展一格，直到不再变化
+template <typename Words, typename Width>
+inline void floodFill(quint64* reach, const quint64* passable, const quint64* notFirstColumn,
+                      const quint64* notLastColumn, quint64* scratch, Words words, Width width) {
+    for (int i = 0; i < words; ++i) reach[i] &= passable[i];
+    while (grow(reach, passable, notFirstColumn, notLastColumn, scratch, words, width)) {
+    }
+}
+
+// 统计置位的格子数
+template <typename Words>
+inline int count(const quint64* bits, Words words) {
+    int total = 0;
+    for (int i = 0; i < words; ++i) total += qPopulationCount(bits[i]);
+    return total;
+}
+
+} // namespace bitboard
+
+// Board 类模板：编译期固定尺寸的位棋盘（例如默认的 20x20 地图只需 7 个字）
+template <int W, int H>
+class Board {
+public:
+    static constexpr int WIDTH = W;
+    static constexpr int HEIGHT = H;
+    static constexpr int CELLS = W * H;
+    static constexpr int WORDS = (CELLS + 63) / 64;
+
+    Board() { bits.fill(0); }
+
+    int width() const { return W; }
+    int height() const { return H; }
+
+    // 清空所有格子
+    void clear() { bits.fill(0); }
+
+    // 单格读写（cell = y * W + x）
+    void set(int cell) { bits[cell >> 6] |= quint64(1) << (cell & 63); }
+    void reset(int cell) { bits[cell >> 6] &= ~(quint64(1) << (cell & 63)); }
+    bool test(int cell) const { return (bits[cell >> 6] >> (cell & 63)) & 1u; }
+
+    // 把所有有效格子置位
+    void fill() { bits = masks().valid; }
+
+    // 置位的格子数
+    int count() const { return bitboard::count(bits.data(), Words()); }
+
+    // 从当前置位的格子出发，在 passable 内洪水填充
+    void floodFill(const Board& passable) {
+        std::array<quint64, 2 * WORDS> scratch;
+        bitboard::floodFill(bits.data(), passable.bits.data(), masks().notFirstColumn.data(),
+                            masks().notLastColumn.data(), scratch.data(), Words(), std::integral_constant<int, W>());
+    }
+
+    // 当前置位的区域向四个方向扩展一格并限制在 passable 内，返回是否变化
+    bool grow(const Board& passable) {
+        std::array<quint64, 2 * WORDS> scratch;
+        return bitboard::grow(bits.data(), passable.bits.data(), masks().notFirstColumn.data(),
+                              masks().notLastColumn.data(), scratch.data(), Words(), std::integral_constant<int, W>());
+    }
+
+    // 位图的字数与原始数据（供按字组合多块棋盘）
+    int wordCount() const { return WORDS; }
+    quint64* data() { return bits.data(); }
+    const quint64* data() const { return bits.data(); }
+
+private:
+    typedef std::integral_constant<int, WORDS> Words;
+
+    struct Masks {
+        std::array<quint64, WORDS> valid;
+        std::array<quint64, WORDS> notFirstColumn;
+        std::array<quint64, WORDS> notLastColumn;
+    };
+
+    // 编译期计算的边界掩码
+    static constexpr Masks buildMasks() {
+        Masks m{};
+        bitboard::buildMasks(W, H, m.valid.data(), m.notFirstColumn.data(), m.notLastColumn.data());
+        return m;
+    }
+
+    static const Masks& masks() {
+        static constexpr Masks value = buildMasks();
+        return value;
+    }
+
+    std::array<quint64, WORDS> bits;
+};
+
+// GenericBoard 类：运行时确定尺寸的位棋盘，用于没有编译期特化的地图尺寸
+class GenericBoard {
+public:
+    GenericBoard(int width, int height)
+        : gridWidth(width), gridHeight(height), words((width * height + 63) / 64),
+          bits(words, 0), valid(words), notFirstColumn(words), notLastColumn(words), scratch(2 * words) {
+        bitboard::buildMasks(width, height, valid.data(), notFirstColumn.data(), notLastColumn.data());
+    }
+
+    int width() const { return gridWidth; }
+    int height() const { return gridHeight; }
+
+    void clear() { std::fill(bits.begin(), bits.end(), 0); }
+
+    void set(int cell) { bits[cell >> 6] |= quint64(1) << (cell & 63); }
+    void reset(int cell) { bits[cell >> 6] &= ~(quint64(1) << (cell & 63)); }
+    bool test(int cell) const { return (bits[cell >> 6] >> (cell & 63)) & 1u; }
+
+    void fill() { bits = valid; }
+
+    int count() const { return bitboard::count(bits.data(), words); }
+
+    // 从当前置位的格子出发，在 passable 内洪水填充（使用构造时分配的临时缓冲区，不分配内存）
+    void floodFill(const GenericBoard& passable) {
+        bitboard::floodFill(bits.data(), passable.bits.data(), notFirstColumn.data(),
+                            notLastColumn.data(), scratch.data(), words, gridWidth);
+    }
+
+    bool grow(const GenericBoard& passable) {
+        return bitboard::grow(bits.data(), passable.bits.data(), notFirstColumn.data(),
+                              notLastColumn.data(), scratch.data(), words, gridWidth);
+    }
+
+    int wordCount() const { return words; }
+    quint64* data() { return bits.data(); }
+    const quint64* data() const { return bits.data(); }
+
+private:
+    int gridWidth;
+    int gridHeight;
+    int words;
+    std::vector<quint64> bits;
+    std::vector<quint64> valid;
+    std::vector<quint64> notFirstColumn;
+    std::vector<quint64> notLastColumn;
+    std::vector<quint64> scratch; // 洪水填充的临时缓冲区（2 * words 个字）
+};
+
+#endif // BITBOARD_H
\ No newline at end of file
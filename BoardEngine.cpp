@@ -0,0 +1,130 @@
+#include "BoardEngine.h"
+#include "GameCore.h"
+#include <algorithm>
+#include <type_traits>
+
+namespace {
+
+// 按尺寸选择位棋盘实现，并以一块空棋盘调用 fn
+template <typename Fn>
+auto withBoard(int width, int height, Fn&& fn) {
+    if (width == 20 && height == 20) return fn(Board<20, 20>());
+    if (width == 10 && height == 10) return fn(Board<10, 10>());
+    if (width == 15 && height == 15) return fn(Board<15, 15>());
+    if (width == 30 && height == 30) return fn(Board<30, 30>());
+    if (width == 40 && height == 40) return fn(Board<40, 40>());
+    return fn(GenericBoard(width, height));
+}
+
+} // namespace
+
+BoardEngine::BoardEngine(int width, int height)
+    : gridWidth(0), gridHeight(0), startCell(0), words(0), occupiedBits(nullptr), passableBits(nullptr),
+      reachBits(nullptr) {
+    resize(width, height);
+}
+
+BoardEngine::BoardEngine(const BoardEngine& other)
+    : gridWidth(other.gridWidth), gridHeight(other.gridHeight), startCell(other.startCell), boards(other.boards),
+      words(0), occupiedBits(nullptr), passableBits(nullptr), reachBits(nullptr) {
+    bind();
+}
+
+BoardEngine& BoardEngine::operator=(const BoardEngine& other) {
+    if (this != &other) {
+        gridWidth = other.gridWidth;
+        gridHeight = other.gridHeight;
+        startCell = other.startCell;
+        boards = other.boards;
+        bind();
+    }
+    return *this;
+}
+
+void BoardEngine::resize(int width, int height) {
+    if (width != gridWidth || height != gridHeight) {
+        gridWidth = width;
+        gridHeight = height;
+        withBoard(width, height, [this](auto empty) { boards.emplace<Boards<decltype(empty)>>(empty); });
+        bind();
+    }
+    std::visit([](auto& b) { b.open.fill(); }, boards);
+    clearOccupied();
+}
+
+void BoardEngine::bind() {
+    std::visit([this](auto& b) {
+        words = b.open.wordCount();
+        occupiedBits = b.occupied.data();
+        passableBits = b.passable.data();
+        reachBits = b.reach.data();
+    }, boards);
+}
+
+bool BoardEngine::isSpecialized() const {
+    return !std::holds_alternative<Boards<GenericBoard>>(boards);
+}
+
+bool BoardEngine::isSpecialized(int width, int height) {
+    return withBoard(width, height, [](const auto& board) {
+        return !std::is_same<std::decay_t<decltype(board)>, GenericBoard>::value;
+    });
+}
+
+void BoardEngine::loadObstacles(const GameCore& core) {
+    std::visit([&](auto& b) {
+        b.open.fill();
+        for (const QPoint& obstacle : core.getObstacles()) {
+            b.open.reset(obstacle.y() * gridWidth + obstacle.x());
+        }
+    }, boards);
+}
+
+void BoardEngine::clearOccupied() {
+    std::fill(occupiedBits, occupiedBits + words, 0);
+}
+
+void BoardEngine::beginFlood(int start) {
+    startCell = start;
+    std::visit([&](auto& b) {
+        const quint64* open = b.open.data();
+        for (int i = 0; i < words; ++i) passableBits[i] = open[i] & ~occupiedBits[i];
+        b.reach.clear();
+        b.reach.set(start);
+    }, boards);
+}
+
+bool BoardEngine::grow() {
+    return std::visit([](auto& b) { return b.reach.grow(b.passable); }, boards);
+}
+
+int BoardEngine::reachedCount() const {
+    const int total = std::visit([](const auto& b) { return b.reach.count(); }, boards);
+    return reached(startCell) ? total - 1 : total;
+}
+
+int BoardEngine::floodCount(int start) {
+    beginFlood(start);
+    while (grow()) {
+    }
+    return reachedCount();
+}
+
+BoardEngine::Reach BoardEngine::reachFromHead(const GameCore& core) {
+    const int width = core.getWidth();
+    const Snake& snake = core.getSnake();
+    resize(width, core.getHeight());
+    loadObstacles(core);
+    Reach result = {0, false};
+    if (snake.getLength() == 0 || !snake.getOccupancy().contains(snake.getHead())) {
+        return result;
+    }
+    // 可通行 = 全部格子 - 障碍物 - 蛇身（蛇头作为起点）
+    for (int i = 1; i < snake.getLength(); ++i) {
+        occupy(snake.cellAt(i));
+    }
+    result.cells = floodCount(snake.cellAt(0));
+    const QPoint food = core.getFood().getPosition();
+    result.foodReachable = snake.getOccupancy().contains(food) && reached(food.y() * width + food.x());
+    return result;
+}
\ No newline at end of file
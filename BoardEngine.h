@@ -0,0 +1,106 @@
+#ifndef BOARDENGINE_H
+#define BOARDENGINE_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <variant>
+#include "BitBoard.h"
+
+class GameCore;
+
+// BoardEngine 类：基于位棋盘的地图分析（可达区域、最短距离），按地图尺寸选择实现
+// 常用尺寸（10x10、15x15、20x20、30x30、40x40）使用编译期特化的 Board<W, H>，其余尺寸使用运行时的 GenericBoard
+// 棋盘在 resize() 时按尺寸分配一次并缓存，之后的分析只做整字运算，不再分配内存
+// 可通行区域 = 全部格子 - 障碍物（loadObstacles()）- 占用标记（occupy() / release()，由调用方逐格维护）
+class BoardEngine {
+public:
+    static constexpr int MAX_FLOOD_CELLS = 64 * 64; // 适合做洪水填充分析的最大格子数（更大的地图跳过分析）
+
+    // 可达区域分析结果
+    struct Reach {
+        int cells;           // 蛇头能到达的空闲格子数（不含蛇头）
+        bool foodReachable;  // 食物是否在可达区域内
+    };
+
+    // 构造函数：按地图尺寸选择实现并分配棋盘
+    explicit BoardEngine(int width = 20, int height = 20);
+
+    // 复制时重新指向本对象自己的棋盘
+    BoardEngine(const BoardEngine& other);
+    BoardEngine& operator=(const BoardEngine& other);
+
+    // 按新的地图尺寸选择实现（尺寸不变时复用已分配的棋盘），并清空障碍物与占用标记
+    void resize(int width, int height);
+
+    // 获取宽度 / 高度
+    int width() const { return gridWidth; }
+    int height() const { return gridHeight; }
+
+    // 当前尺寸 / 给定尺寸是否有编译期特化
+    bool isSpecialized() const;
+    static bool isSpecialized(int width, int height);
+
+    // 该尺寸是否适合做洪水填充分析
+    static bool canFloodFill(int width, int height) { return width * height <= MAX_FLOOD_CELLS; }
+
+    // 按 core 的障碍物重新设置可通行区域（不改变占用标记）
+    void loadObstacles(const GameCore& core);
+
+    // 标记 / 取消标记被占用的格子（cell = y * width + x）
+    void occupy(int cell) { occupiedBits[cell >> 6] |= quint64(1) << (cell & 63); }
+    void release(int cell) { occupiedBits[cell >> 6] &= ~(quint64(1) << (cell & 63)); }
+
+    // 清除所有占用标记
+    void clearOccupied();
+
+    // 开始一次从 start 出发的扩展：可通行区域取当前的障碍物与占用标记，start 本身不必可通行
+    void beginFlood(int start);
+
+    // 在本次扩展中把 cell 视为可通行（例如下一步就会移走的蛇尾）
+    void allow(int cell) { passableBits[cell >> 6] |= quint64(1) << (cell & 63); }
+
+    // 扩展一步：可达区域向四个方向各前进一格，区域不再变化时返回 false
+    // 第 k 次返回 true 之后新出现在可达区域中的格子，到 start 的最短距离都是 k
+    bool grow();
+
+    // cell 是否已在可达区域内
+    bool reached(int cell) const { return (reachBits[cell >> 6] >> (cell & 63)) & 1u; }
+
+    // 可达区域中的格子数（不含 start）
+    int reachedCount() const;
+
+    // 从 start 出发扩展到不再变化，返回可到达的格子数（不含 start）
+    int floodCount(int start);
+
+    // 从蛇头出发、绕开蛇身与障碍物的可达区域（按 core 重新设置尺寸、障碍物与占用标记）
+    Reach reachFromHead(const GameCore& core);
+
+private:
+    // 同一尺寸、同一实现的四块棋盘
+    template <typename B>
+    struct Boards {
+        Boards() {}
+        explicit Boards(const B& empty) : open(empty), occupied(empty), passable(empty), reach(empty) {}
+        B open;      // 全部格子 - 障碍物
+        B occupied;  // 占用标记
+        B passable;  // 本次扩展的可通行区域
+        B reach;     // 本次扩展的可达区域
+    };
+
+    typedef std::variant<Boards<Board<20, 20>>, Boards<Board<10, 10>>, Boards<Board<15, 15>>,
+                         Boards<Board<30, 30>>, Boards<Board<40, 40>>, Boards<GenericBoard>> Storage;
+
+    // 记下当前棋盘的原始字（单格读写不经过实现分发）
+    void bind();
+
+    int gridWidth;
+    int gridHeight;
+    int startCell;             // 本次扩展的起点
+    Storage boards;
+    int words;                 // 每块棋盘的字数
+    quint64* occupiedBits;
+    quint64* passableBits;
+    const quint64* reachBits;
+};
+
+#endif // BOARDENGINE_H
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef BUMPARENA_H
+#define BUMPARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// BumpArena 类：只增不减的内存分配器，分配只是移动指针，reset() 一次性回收全部内存
+// 内存按 BLOCK_SIZE 的块向系统申请，reset() 后块保留复用，稳定运行时不再向系统申请内存
+// 对象的析构函数不会被调用，只能存放可平凡析构的类型（例如搜索树节点）；不是线程安全的，每个线程各用一个
+class BumpArena {
+public:
+    static constexpr size_t BLOCK_SIZE = 256 * 1024; // 每块的字节数
+
+    BumpArena() : block(0), offset(0), used(0) {}
+
+    // 分配 size 字节、按 align 对齐的内存
+    void* allocate(size_t size, size_t align) {
+        for (;;) {
+            if (block < blocks.size()) {
+                const size_t start = (offset + align - 1) & ~(align - 1);
+                if (start + size <= BLOCK_SIZE) {
+                    offset = start + size;
+                    used += size;
+                    return blocks[block].get() + start;
+                }
+                ++block;
+                offset = 0;
+                continue;
+            }
+            blocks.emplace_back(new std::byte[BLOCK_SIZE]); // operator new 按 max_align_t 对齐
+        }
+    }
+
+    // 在 arena 中构造一个 T（size 不超过 BLOCK_SIZE）
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "BumpArena never runs destructors");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // 回收全部分配（保留已申请的块）
+    void reset() {
+        block = 0;
+        offset = 0;
+        used = 0;
+    }
+
+    // 自上次 reset() 以来分配的字节数 / 已向系统申请的字节数
+    size_t bytesUsed() const { return used; }
+    size_t bytesReserved() const { return blocks.size() * BLOCK_SIZE; }
+
+private:
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    size_t block;   // 当前使用的块
+    size_t offset;  // 当前块中下一次分配的起点
+    size_t used;
+};
+
+#endif // BUMPARENA_H
\ No newline at end of file
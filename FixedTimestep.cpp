@@ -0,0 +1,38 @@
+#include "FixedTimestep.h"
+
+FixedTimestep::FixedTimestep()
+    : stepNanos(0), lastNanos(0), accumulator(0), running(false), ticks(0), late(0), dropped(0) {}
+
+void FixedTimestep::start(qint64 step) {
+    stepNanos = step;
+    accumulator = 0;
+    ticks = 0;
+    late = 0;
+    dropped = 0;
+    running = stepNanos > 0;
+    clock.start();
+    lastNanos = 0;
+}
+
+int FixedTimestep::advance() {
+    if (!running) return 0;
+    const qint64 now = clock.nsecsElapsed();
+    accumulator += now - lastNanos;
+    lastNanos = now;
+
+    // 积压过多时只保留最近 MAX_BACKLOG_NANOS，其余的帧丢弃（否则恢复后会长时间快进）
+    if (accumulator > MAX_BACKLOG_NANOS + stepNanos) {
+        const qint64 excess = (accumulator - MAX_BACKLOG_NANOS) / stepNanos;
+        dropped += static_cast<quint64>(excess);
+        accumulator -= excess * stepNanos;
+    }
+
+    const int due = static_cast<int>(accumulator / stepNanos);
+    accumulator -= due * stepNanos;
+    // 第 k 帧（0 起）的到期时间比现在早 accumulator + (due - 1 - k) * step，除最后一帧外都已迟到一个步长以上
+    if (due > 1) {
+        late += static_cast<quint64>(due - 1);
+    }
+    ticks += static_cast<quint64>(due);
+    return due;
+}
\ No newline at end of file
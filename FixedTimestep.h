@@ -0,0 +1,62 @@
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+// FixedTimestep 类：基于单调时钟（QElapsedTimer）的固定步长累加器
+// 每次 advance() 把距上次调用经过的真实时间加入累加器，按固定步长取出到期的逻辑帧数，
+// 余下不足一帧的时间作为插值系数 alpha() 交给渲染，因此游戏速度只取决于时钟，与定时器抖动和绘制耗时无关
+// 落后时连续补跑多帧以保持速度准确；积压超过 MAX_BACKLOG_NANOS（例如窗口被拖动、调试器暂停）的部分直接丢弃
+class FixedTimestep {
+public:
+    static constexpr qint64 MAX_BACKLOG_NANOS = 250000000; // 最多补跑 250 ms 的积压
+
+    // 构造函数：创建未运行的累加器
+    FixedTimestep();
+
+    // 以给定步长（纳秒）开始计时，累加器清零
+    void start(qint64 stepNanos);
+
+    // 停止计时（之后 advance() 返回 0）
+    void stop() { running = false; }
+
+    // 是否正在计时
+    bool isRunning() const { return running; }
+
+    // 读取时钟，返回本次应执行的逻辑帧数（可能为 0 或多帧）
+    // 到期时间已超过一个步长的帧记为迟到（lateTicks）
+    int advance();
+
+    // 上一帧之后经过的时间占一个步长的比例，范围 [0, 1)，用于在前后两帧之间插值
+    qreal alpha() const { return running && stepNanos > 0 ? qreal(accumulator) / stepNanos : 0.0; }
+
+    // 步长（纳秒）
+    qint64 step() const { return stepNanos; }
+
+    // 从 start() 起经过的时间（纳秒）
+    qint64 elapsed() const { return clock.nsecsElapsed(); }
+
+    // 最近一次 advance() 执行的最后一帧的到期时刻（相对 start()，纳秒）
+    qint64 lastTickDue() const { return lastNanos - accumulator; }
+
+    // 距下一帧到期还有多久（纳秒，已到期时为 0 或负数），用于在两帧之间休眠
+    qint64 untilNextTick() const { return stepNanos - accumulator - (clock.nsecsElapsed() - lastNanos); }
+
+    // 统计：已执行的帧数 / 迟到的帧数 / 因积压过多而丢弃的帧数（从 start() 起计）
+    quint64 tickCount() const { return ticks; }
+    quint64 lateTicks() const { return late; }
+    quint64 droppedTicks() const { return dropped; }
+
+private:
+    QElapsedTimer clock; // 单调时钟
+    qint64 stepNanos;    // 固定步长
+    qint64 lastNanos;    // 上次 advance() 时的时钟读数
+    qint64 accumulator;  // 尚未消耗的时间
+    bool running;
+    quint64 ticks;
+    quint64 late;
+    quint64 dropped;
+};
+
+#endif // FIXEDTIMESTEP_H
\ No newline at end of file
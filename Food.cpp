@@ -1,39 +1,20 @@
 #include "Food.h"
-#include <cstdlib>
-#include <ctime>
-#include <QList>
+#include "Zobrist.h"
 
 Food::Food() {
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
     position = QPoint(5, 5);
+    hash = 0;
 }
 
-void Food::respawn(int width, int height, const std::deque<QPoint>& snakeBody, const QList<QPoint>& obstacles) {
-    while (true) {
-        int x = std::rand() % width;
-        int y = std::rand() % height;
-        QPoint newPos(x, y);
-        bool overlap = false;
-        for (const auto& part : snakeBody) {
-            if (part == newPos) {
-                overlap = true;
-                break;
-            }
-        }
-        if (!overlap) {
-            for (const auto& obstacle : obstacles) {
-                if (obstacle == newPos) {
-                    overlap = true;
-                    break;
-                }
-            }
-        }
-
-        if (!overlap) {
-            position = newPos;
-            break;
-        }
+bool Food::respawn(const FreeCellSet& freeCells, Random& rng) {
+    if (freeCells.isEmpty()) {
+        position = QPoint(-1, -1); // 地图已满，不再放置食物
+        hash = 0;
+        return false;
     }
+    position = freeCells.at(rng.bounded(freeCells.size()));
+    hash = Zobrist::food(static_cast<quint32>(position.y() * freeCells.width() + position.x()));
+    return true;
 }
 
 QPoint Food::getPosition() const {
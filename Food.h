@@ -1,9 +1,9 @@
 #ifndef FOOD_H
 #define FOOD_H
 
-#include <deque>
 #include <QPoint>
-#include <QList>
+#include "FreeCellSet.h"
+#include "Random.h"
 
 // Food 类：表示游戏中的食物对象，负责食物的位置管理与重新生成
 class Food {
@@ -12,19 +12,22 @@ public:
     Food();
 
     /**
-     * 重新生成食物位置
-     * @param width 地图宽度
-     * @param height 地图高度
-     * @param snakeBody 当前蛇的身体，用于避免生成在蛇身上
-     * @param obstacles 当前地图中的障碍物，用于避免生成在障碍物位置
+     * 重新生成食物位置：从空闲格子集合中 O(1) 均匀随机选取一个格子
+     * @param freeCells 当前不被蛇身和障碍物占用的格子集合
+     * @param rng 本局游戏的随机数生成器
+     * @return 是否成功生成；没有空闲格子（地图已被填满）时返回 false
      */
-    void respawn(int width, int height, const std::deque<QPoint>& snakeBody, const QList<QPoint>& obstacles);
+    bool respawn(const FreeCellSet& freeCells, Random& rng);
 
     // 获取当前食物的位置
     QPoint getPosition() const;
 
+    // 食物格子的 Zobrist 键（地图已满、没有食物时为 0），与 Snake::getHash() 异或即为整局状态散列
+    quint64 getHash() const { return hash; }
+
 private:
     QPoint position; // 当前食物的坐标
+    quint64 hash;    // 食物格子的散列键，随 respawn() 更新
 };
 
 #endif // FOOD_H
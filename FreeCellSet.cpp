@@ -0,0 +1,131 @@
+#include "FreeCellSet.h"
+#include <QtAlgorithms>
+#include <algorithm>
+
+FreeCellSet::FreeCellSet(int width, int height)
+    : gridWidth(0), gridHeight(0), freeCount(0), dense(true), fenwickStep(0) {
+    reset(width, height);
+}
+
+void FreeCellSet::reset(int width, int height) {
+    gridWidth = std::max(0, width);
+    gridHeight = std::max(0, height);
+    const int total = gridWidth * gridHeight;
+    freeCount = total;
+    dense = total <= DENSE_LIMIT;
+
+    if (dense) {
+        cells.resize(total);
+        positions.resize(total);
+        for (int i = 0; i < total; ++i) {
+            cells[i] = i;
+            positions[i] = i;
+        }
+        return;
+    }
+
+    // 分块模式：所有格子空闲，树状数组按每块的有效格子数初始化（线性建树）
+    cells.clear();
+    positions.clear();
+    if (blocked.width() == gridWidth && blocked.height() == gridHeight) {
+        blocked.clear();
+    } else {
+        blocked.resize(gridWidth, gridHeight);
+    }
+    const int tiles = blocked.tileCount();
+    fenwick.assign(tiles + 1, 0);
+    for (int t = 0; t < tiles; ++t) {
+        const int tx = t % blocked.tilesX();
+        const int ty = t / blocked.tilesX();
+        const int columns = std::min(OccupancyGrid::TILE_SIZE, gridWidth - (tx << OccupancyGrid::TILE_SHIFT));
+        const int rows = std::min(OccupancyGrid::TILE_SIZE, gridHeight - (ty << OccupancyGrid::TILE_SHIFT));
+        fenwick[t + 1] += columns * rows;
+        const int parent = (t + 1) + ((t + 1) & -(t + 1));
+        if (parent <= tiles) {
+            fenwick[parent] += fenwick[t + 1];
+        }
+    }
+    fenwickStep = 1;
+    while (fenwickStep * 2 <= tiles) {
+        fenwickStep *= 2;
+    }
+}
+
+void FreeCellSet::insert(const QPoint& cell) {
+    if (!inBounds(cell)) return;
+    if (dense) {
+        const int index = cell.y() * gridWidth + cell.x();
+        if (positions[index] >= 0) return;
+        positions[index] = static_cast<int>(cells.size());
+        cells.push_back(index);
+    } else {
+        if (!blocked.test(cell)) return;
+        blocked.reset(cell);
+        addTileFree(blocked.tileOf(cell), 1);
+    }
+    ++freeCount;
+}
+
+void FreeCellSet::remove(const QPoint& cell) {
+    if (!inBounds(cell)) return;
+    if (dense) {
+        const int index = cell.y() * gridWidth + cell.x();
+        const int pos = positions[index];
+        if (pos < 0) return;
+        // 用末尾元素填补空位
+        const int last = cells.back();
+        cells[pos] = last;
+        positions[last] = pos;
+        cells.pop_back();
+        positions[index] = -1;
+    } else {
+        if (blocked.test(cell)) return;
+        blocked.set(cell);
+        addTileFree(blocked.tileOf(cell), -1);
+    }
+    --freeCount;
+}
+
+bool FreeCellSet::contains(const QPoint& cell) const {
+    if (!inBounds(cell)) return false;
+    if (dense) return positions[cell.y() * gridWidth + cell.x()] >= 0;
+    return !blocked.test(cell);
+}
+
+void FreeCellSet::addTileFree(int tile, int delta) {
+    const int tiles = static_cast<int>(fenwick.size()) - 1;
+    for (int i = tile + 1; i <= tiles; i += i & -i) {
+        fenwick[i] += delta;
+    }
+}
+
+QPoint FreeCellSet::sparseAt(int i) const {
+    // 在树状数组上二分，找到第 i 个空闲格子所在的分块
+    const int tiles = static_cast<int>(fenwick.size()) - 1;
+    int tile = 0;
+    for (int step = fenwickStep; step > 0; step >>= 1) {
+        if (tile + step <= tiles && fenwick[tile + step] <= i) {
+            tile += step;
+            i -= fenwick[tile];
+        }
+    }
+
+    // 在块内逐行统计空闲位，定位到具体格子
+    const int originX = (tile % blocked.tilesX()) << OccupancyGrid::TILE_SHIFT;
+    const int originY = (tile / blocked.tilesX()) << OccupancyGrid::TILE_SHIFT;
+    const int columns = std::min(OccupancyGrid::TILE_SIZE, gridWidth - originX);
+    const int rows = std::min(OccupancyGrid::TILE_SIZE, gridHeight - originY);
+    const quint64 validMask = columns == 64 ? ~quint64(0) : (quint64(1) << columns) - 1;
+    for (int row = 0; row < rows; ++row) {
+        quint64 mask = ~blocked.tileRow(tile, row) & validMask;
+        const int count = qPopulationCount(mask);
+        if (i < count) {
+            for (; i > 0; --i) {
+                mask &= mask - 1; // 去掉最低位的 1
+            }
+            return QPoint(originX + qCountTrailingZeroBits(mask), originY + row);
+        }
+        i -= count;
+    }
+    return QPoint(-1, -1); // 下标越界
+}
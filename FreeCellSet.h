@@ -0,0 +1,74 @@
+#ifndef FREECELLSET_H
+#define FREECELLSET_H
+
+#include <QPoint>
+#include <vector>
+#include "OccupancyGrid.h"
+
+// FreeCellSet 类：地图空闲格子集合，支持插入、删除以及按下标取第 i 个空闲格子（用于均匀随机选取）
+// 小地图使用稠密数组 + 位置索引：删除时把末尾元素换到被删位置（swap-remove），所有操作 O(1)
+// 大地图（格子数超过 DENSE_LIMIT）改为记录“非空闲”格子的分块位图，并用树状数组统计每块的空闲数，
+// 操作为 O(log 分块数)，内存只与被占用区域成正比
+class FreeCellSet {
+public:
+    static constexpr int DENSE_LIMIT = 1 << 16; // 使用稠密数组的最大格子数
+
+    // 构造函数：创建指定宽高的集合，初始时所有格子都空闲
+    FreeCellSet(int width = 0, int height = 0);
+
+    // 重置为指定尺寸，所有格子都空闲
+    void reset(int width, int height);
+
+    // 将格子加入空闲集合（越界或已存在时忽略）
+    void insert(const QPoint& cell);
+
+    // 将格子移出空闲集合（越界或不存在时忽略）
+    void remove(const QPoint& cell);
+
+    // 判断格子是否空闲
+    bool contains(const QPoint& cell) const;
+
+    // 地图宽度（格子编号为 y * width + x）
+    int width() const { return gridWidth; }
+
+    // 空闲格子数量
+    int size() const { return freeCount; }
+
+    // 是否已没有空闲格子
+    bool isEmpty() const { return freeCount == 0; }
+
+    // 获取第 i 个空闲格子（0 <= i < size()）
+    // 稠密模式下顺序由插入/删除历史决定；分块模式下按分块、块内按行优先排列
+    QPoint at(int i) const {
+        if (dense) return QPoint(cells[i] % gridWidth, cells[i] / gridWidth);
+        return sparseAt(i);
+    }
+
+private:
+    // 坐标是否在地图范围内
+    bool inBounds(const QPoint& cell) const {
+        return cell.x() >= 0 && cell.x() < gridWidth && cell.y() >= 0 && cell.y() < gridHeight;
+    }
+
+    // 分块模式：树状数组上给第 tile 块的空闲数加上 delta
+    void addTileFree(int tile, int delta);
+
+    // 分块模式：第 i 个空闲格子
+    QPoint sparseAt(int i) const;
+
+    int gridWidth;              // 地图宽度（格子数）
+    int gridHeight;             // 地图高度（格子数）
+    int freeCount;              // 空闲格子数量
+    bool dense;                 // 是否使用稠密数组模式
+
+    // 稠密模式
+    std::vector<int> cells;     // 稠密数组：所有空闲格子的编号（y * width + x）
+    std::vector<int> positions; // 位置索引：格子编号 -> 在 cells 中的下标，-1 表示不空闲
+
+    // 分块模式
+    OccupancyGrid blocked;      // 非空闲格子的分块位图
+    std::vector<int> fenwick;   // 各分块空闲格子数的树状数组（下标从 1 开始）
+    int fenwickStep;            // 树状数组二分查找的起始步长（不超过分块数的最大 2 的幂）
+};
+
+#endif // FREECELLSET_H
@@ -0,0 +1,49 @@
+#include "GLBoardWidget.h"
+#include <QOpenGLContext>
+#include <QSurfaceFormat>
+#include <QTimer>
+
+GLBoardWidget::GLBoardWidget(SnakeGame* game, QWidget* parent)
+    : QOpenGLWidget(parent), game(game) {
+    // 请求 OpenGL 3.3 Core（OpenGL ES 平台上 Qt 会改为创建 ES 3.0 上下文）
+    QSurfaceFormat surfaceFormat = format();
+    surfaceFormat.setVersion(3, 3);
+    surfaceFormat.setProfile(QSurfaceFormat::CoreProfile);
+    setFormat(surfaceFormat);
+    // 不接收焦点与鼠标，键盘和点击仍交给 GameRenderer
+    setFocusPolicy(Qt::NoFocus);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+}
+
+GLBoardWidget::~GLBoardWidget() {
+    // 释放 OpenGL 资源时上下文必须是当前的
+    if (context()) {
+        makeCurrent();
+        board.release();
+        doneCurrent();
+    }
+}
+
+void GLBoardWidget::setPalette(const QVector<QColor>& colors) {
+    board.setPalette(colors);
+    update();
+}
+
+void GLBoardWidget::initializeGL() {
+    QOpenGLContext* current = context();
+    const QSurfaceFormat actual = current ? current->format() : QSurfaceFormat();
+    const bool supported = current && current->isValid()
+        && (current->isOpenGLES() ? actual.majorVersion() >= 3
+                                  : actual.version() >= qMakePair(3, 3));
+    if (!supported || !board.initialize()) {
+        // 在初始化回调中不能删除自己，留到事件循环中再通知
+        QTimer::singleShot(0, this, &GLBoardWidget::initializationFailed);
+    }
+}
+
+void GLBoardWidget::paintGL() {
+    if (!board.isInitialized()) return;
+    board.sync(game->getCore(), game->getSnake(), game->getFood(), game->getTickCount());
+    const qreal ratio = devicePixelRatio();
+    board.render(qRound(width() * ratio), qRound(height() * ratio));
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef GLBOARDWIDGET_H
+#define GLBOARDWIDGET_H
+
+#include <QOpenGLWidget>
+#include <QVector>
+#include <QColor>
+#include "InstancedBoardRenderer.h"
+#include "SnakeGame.h"
+
+// GLBoardWidget 类：基于 QOpenGLWidget 的棋盘绘制后端，作为 GameRenderer 的子窗口覆盖在棋盘区域上
+// 只负责棋盘内容（一次实例化绘制），菜单、分数栏与键盘输入仍由 GameRenderer 处理
+// 上下文创建或着色器编译失败时发出 initializationFailed()，由 GameRenderer 回退到 QPainter 绘制
+class GLBoardWidget : public QOpenGLWidget {
+    Q_OBJECT
+public:
+    // 构造函数：接收 SnakeGame 指针与父窗口指针
+    explicit GLBoardWidget(SnakeGame* game, QWidget* parent = nullptr);
+    ~GLBoardWidget() override;
+
+    // 设置调色板（颜色按 InstancedBoardRenderer::CellKind 顺序排列）
+    void setPalette(const QVector<QColor>& colors);
+
+    // OpenGL 是否已成功初始化（首次显示之前为 false）
+    bool isReady() const { return board.isInitialized(); }
+
+signals:
+    // OpenGL 不可用（上下文无效、版本过低或着色器编译失败）
+    void initializationFailed();
+
+protected:
+    // OpenGL 回调：创建资源 / 绘制一帧
+    void initializeGL() override;
+    void paintGL() override;
+
+private:
+    SnakeGame* game;                // 游戏主逻辑控制器
+    InstancedBoardRenderer board;   // 实例化绘制器
+};
+
+#endif // GLBOARDWIDGET_H
\ No newline at end of file
@@ -0,0 +1,27 @@
+#include "GameClock.h"
+
+GameClock::GameClock()
+    : banked(0), running(false) {}
+
+void GameClock::reset() {
+    banked = 0;
+    running = false;
+}
+
+void GameClock::start() {
+    banked = 0;
+    running = true;
+    clock.start();
+}
+
+void GameClock::pause() {
+    if (!running) return;
+    banked += clock.nsecsElapsed();
+    running = false;
+}
+
+void GameClock::resume() {
+    if (running) return;
+    running = true;
+    clock.start();
+}
\ No newline at end of file
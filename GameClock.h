@@ -0,0 +1,40 @@
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+// GameClock 类：可暂停的单调游戏时钟（QElapsedTimer，纳秒精度，按毫秒读取）
+// 只在读取时计算已走时间，不依赖任何定时器，因此不会在菜单或暂停时唤醒事件循环；
+// 暂停期间的时间不计入，恢复后从暂停时的读数继续
+class GameClock {
+public:
+    // 构造函数：创建停止且读数为 0 的时钟
+    GameClock();
+
+    // 停止并归零
+    void reset();
+
+    // 归零并开始计时
+    void start();
+
+    // 暂停（已走时间保留；未运行时无操作）
+    void pause();
+
+    // 从暂停处继续（已在运行时无操作）
+    void resume();
+
+    // 是否正在计时
+    bool isRunning() const { return running; }
+
+    // 已走时间（纳秒 / 毫秒，不含暂停期间）
+    qint64 elapsedNanos() const { return running ? banked + clock.nsecsElapsed() : banked; }
+    qint64 elapsedMillis() const { return elapsedNanos() / 1000000; }
+
+private:
+    QElapsedTimer clock; // 本段计时的起点（最近一次 start() / resume()）
+    qint64 banked;       // 之前各段累计的时间（纳秒）
+    bool running;
+};
+
+#endif // GAMECLOCK_H
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "GameCore.h"
+#include <algorithm>
+
+GameCore::GameCore(int width, int height)
+    : gridWidth(width), gridHeight(height), snake(width, height),
+      obstacleGrid(width, height), freeCells(width, height), score(0), gameOverFlag(false),
+      boardCompleteFlag(false), tickCount(0) {
+}
+
+void GameCore::reset(quint64 seed, bool obstacleMap) {
+    rng.seed(seed);
+    snake.reset();
+    score = 0;
+    gameOverFlag = false;
+    boardCompleteFlag = false;
+    tickCount = 0;
+    obstacles.clear(); // 清空障碍物
+    obstacleGrid.clear();
+
+    // 初始化空闲格子集合：去掉蛇身占用的格子，障碍物在生成时移除
+    freeCells.reset(gridWidth, gridHeight);
+    for (const QPoint& part : snake.getBody()) {
+        freeCells.remove(part);
+    }
+    if (obstacleMap) {
+        generateObstacles();
+    }
+
+    if (!spawnFood()) {
+        boardCompleteFlag = true;
+        gameOverFlag = true;
+    }
+}
+
+void GameCore::generateObstacles() {
+    // 生成边界障碍物
+    for (int x = 0; x < gridWidth; ++x) {
+        addObstacle(QPoint(x, 0));              // 上边界
+        addObstacle(QPoint(x, gridHeight - 1)); // 下边界
+    }
+    for (int y = 1; y < gridHeight - 1; ++y) {
+        addObstacle(QPoint(0, y));             // 左边界
+        addObstacle(QPoint(gridWidth - 1, y)); // 右边界
+    }
+
+    // 添加一些内部障碍物（数量适中）
+    // 此时空闲格子集合中只剩内部且不在蛇身上的格子，直接从中均匀抽取，无需重试和查重
+    // 默认 20x20 地图放 15 个，更大的地图按内部面积等比例增加
+    const qint64 interior = static_cast<qint64>(std::max(0, gridWidth - 2)) * std::max(0, gridHeight - 2);
+    const int numObstacles = static_cast<int>(std::max<qint64>(15, 15 * interior / (18 * 18)));
+    for (int i = 0; i < numObstacles && !freeCells.isEmpty(); ++i) {
+        addObstacle(freeCells.at(rng.bounded(freeCells.size())));
+    }
+}
+
+void GameCore::addObstacle(const QPoint& cell) {
+    if (obstacleGrid.test(cell)) return; // 小地图上边界可能重叠
+    obstacleGrid.set(cell);
+    obstacles.append(cell);
+    freeCells.remove(cell);
+}
+
+void GameCore::setDirection(Snake::Direction dir) {
+    snake.setDirection(dir);
+}
+
+GameCore::StepResult GameCore::step(Snake::Direction dir) {
+    snake.setDirection(dir);
+    return step();
+}
+
+GameCore::StepResult GameCore::step() {
+    if (gameOverFlag) return AlreadyOver;
+    ++tickCount;
+
+    // 维护空闲格子集合：空出的尾部加入，新蛇头移除
+    snake.move();
+    if (snake.hasVacatedTail()) {
+        freeCells.insert(snake.getVacatedTail());
+    }
+    freeCells.remove(snake.getHead());
+
+    const StepResult result = checkCollisions();
+    if (result != Moved && result != AteFood) {
+        gameOverFlag = true;
+    }
+    return result;
+}
+
+GameCore::StepResult GameCore::checkCollisions() {
+    QPoint head = snake.getHead();
+    // Wall collision
+    if (!snake.getOccupancy().contains(head)) {
+        return HitWall;
+    }
+    // Self collision
+    if (snake.checkSelfCollision()) {
+        return HitSelf;
+    }
+    // Obstacle collision
+    if (obstacleGrid.test(head)) {
+        return HitObstacle;
+    }
+    // Food collision
+    if (head == food.getPosition()) {
+        snake.grow();
+        score += 10;
+        if (!spawnFood()) {
+            // 没有空闲格子：蛇已填满整张地图，判定获胜
+            boardCompleteFlag = true;
+            return BoardComplete;
+        }
+        return AteFood;
+    }
+    return Moved;
+}
+
+bool GameCore::spawnFood() {
+    return food.respawn(freeCells, rng);
+}
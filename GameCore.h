@@ -0,0 +1,92 @@
+#ifndef GAMECORE_H
+#define GAMECORE_H
+
+#include <QPoint>
+#include <QList>
+#include "Snake.h"
+#include "Food.h"
+#include "FreeCellSet.h"
+#include "OccupancyGrid.h"
+#include "Random.h"
+
+// GameCore 类：不依赖 QObject、信号或定时器的无界面游戏核心
+// 只保存游戏状态并提供 step() 推进一个逻辑帧，可在任意线程中以最快速度运行（模拟、AI 训练等）
+class GameCore {
+public:
+    static constexpr int MIN_SIZE = 5;    // 地图最小边长（界面与录像读取共用）
+    static constexpr int MAX_SIZE = 4096; // 地图最大边长
+
+    // 单步推进的结果
+    enum StepResult {
+        Moved,          // 正常移动
+        AteFood,        // 吃到食物
+        HitWall,        // 撞墙
+        HitSelf,        // 撞到自身
+        HitObstacle,    // 撞到障碍物
+        BoardComplete,  // 蛇填满整张地图（获胜）
+        AlreadyOver     // 游戏已经结束，本次调用没有效果
+    };
+
+    // 构造函数：指定地图尺寸
+    explicit GameCore(int width = 20, int height = 20);
+
+    // 开始新的一局：使用给定种子，obstacleMap 为 true 时生成障碍物地图
+    void reset(quint64 seed, bool obstacleMap);
+
+    // 设置蛇的移动方向（禁止直接掉头）
+    void setDirection(Snake::Direction dir);
+
+    // 推进一个逻辑帧：移动蛇、检测碰撞、处理吃食物
+    StepResult step();
+
+    // 先改变方向再推进一个逻辑帧
+    StepResult step(Snake::Direction dir);
+
+    // 状态查询
+    int getWidth() const { return gridWidth; }
+    int getHeight() const { return gridHeight; }
+    const Snake& getSnake() const { return snake; }
+    const Food& getFood() const { return food; }
+    const QList<QPoint>& getObstacles() const { return obstacles; }
+    const OccupancyGrid& getObstacleGrid() const { return obstacleGrid; }
+    bool isObstacle(const QPoint& cell) const { return obstacleGrid.test(cell); }
+    const FreeCellSet& getFreeCells() const { return freeCells; }
+    int getScore() const { return score; }
+    bool isGameOver() const { return gameOverFlag; }
+    bool isBoardComplete() const { return boardCompleteFlag; }
+    quint64 getSeed() const { return rng.getSeed(); }
+    const Random& getRandom() const { return rng; }
+    quint64 getTickCount() const { return tickCount; }
+
+    // 状态散列：蛇与食物的 Zobrist 键异或，每帧 O(1) 增量维护。两次运行在同一帧的散列相同即状态一致，
+    // 录像与联机对局只需比较一个 64 位整数即可发现不同步；障碍物由种子决定、得分由蛇长决定，不计入
+    quint64 getHash() const { return snake.getHash() ^ food.getHash(); }
+
+private:
+    // 生成障碍物地图（边界 + 随机内部障碍），需在空闲格子集合初始化之后调用
+    void generateObstacles();
+
+    // 放置一个障碍物：同时写入位图、渲染用列表并移出空闲格子集合
+    void addObstacle(const QPoint& cell);
+
+    // 检查碰撞（墙、自身、障碍），处理吃食物
+    StepResult checkCollisions();
+
+    // 生成新食物，没有空闲格子时返回 false
+    bool spawnFood();
+
+    int gridWidth;             // 地图宽度（格子数）
+    int gridHeight;            // 地图高度（格子数）
+    Snake snake;               // 蛇对象
+    Food food;                 // 食物对象
+    QList<QPoint> obstacles;   // 障碍物位置列表（仅供渲染遍历）
+    OccupancyGrid obstacleGrid; // 障碍物位图（用于 O(1) 碰撞检测）
+    FreeCellSet freeCells;     // 不被蛇身和障碍物占用的空闲格子集合（用于 O(1) 生成食物）
+    Random rng;                // 本局游戏的随机数生成器（食物与障碍物生成共用）
+    int score;                 // 当前得分
+    bool gameOverFlag;         // 游戏结束标志
+    bool boardCompleteFlag;    // 填满地图获胜标志
+    quint64 tickCount;         // 本局已推进的逻辑帧数
+};
+
+#endif // GAMECORE_H
@@ -1,26 +1,41 @@
 #include "Snake.h"
 #include "SnakeGame.h"
 #include "GameRenderer.h"
+#include "GLBoardWidget.h"
 #include <QPainter>
 #include <QKeyEvent>
 #include <QTimer>
 #include <QConicalGradient>
 #include <cmath>
+#include <algorithm>
+#include <QtMath>
 #include <QPainterPath>
+#include <QScreen>
+#include <QEvent>
+#include <QHideEvent>
+#include <QShowEvent>
 #include "Food.h"
 
 const int CELL_SIZE = 25;
-const int GRID_WIDTH = 20;
-const int GRID_HEIGHT = 20;
+const int MAX_BOARD_PIXELS = 500;  // 棋盘较长边的最大像素数（默认 20x20 地图正好不缩放）
+const int MIN_GRID_LINE_PIXELS = 4; // 每格小于该像素数时不再绘制网格线
+const int DIRTY_MARGIN = 2;         // 局部重绘区域在格子四周额外留出的像素（覆盖描边与抗锯齿）
+const int SPRITE_PADDING = 2;       // 精灵在格子四周额外留出的逻辑单位（覆盖描边与抗锯齿）
+const int BODY_SPRITES = 10;        // 蛇身精灵数：10 种彩虹色相（纯色方案下按奇偶深浅交替，10 为偶数正好对应）
+const int HEAD_SPRITES = 4;         // 蛇头精灵数：当前形状的 4 个方向（顺序同 Snake::Direction）
+const int FOOD_FRAMES = 16;         // 食物呼吸动画的帧数
+const int FOOD_PULSE_MS = 100;      // 食物呼吸动画的推进间隔（相位每次前进 0.1 弧度，精灵帧约每 4 次才变化一次）
+const qreal TWO_PI = 6.28318530717958647692;
+const QRect MENU_FOOD_RECT(60, 0, 20, 20); // 菜单预览食物相对预览原点的区域
+const int LEADERBOARD_LINES = 5;    // 游戏结束界面显示的排行榜条数
 const int HEAD_EYE_SIZE = 4;
 
 GameRenderer::GameRenderer(SnakeGame* game, QWidget* parent)
     : QWidget(parent), game(game),
       gameTimer(new QTimer(this)),
-      foodAnimationTimer(new QTimer(this))
-      
+      animations(this)
 {
-    setFixedSize(GRID_WIDTH * CELL_SIZE, GRID_HEIGHT * CELL_SIZE + 50);
+    updateBoardGeometry();
     setFocusPolicy(Qt::StrongFocus);
     // 初始化颜色
     snakeHeadColor = QColor(0, 200, 0);
@@ -30,40 +45,155 @@ GameRenderer::GameRenderer(SnakeGame* game, QWidget* parent)
     pal.setColor(QPalette::Window, QColor(30, 30, 40));
     setAutoFillBackground(true);
     setPalette(pal);
-    // 游戏主定时器
+    // 显示帧定时器：执行到期的逻辑帧，再按插值系数重绘正在移动的蛇头与蛇尾
+    gameTimer->setTimerType(Qt::PreciseTimer);
     connect(gameTimer, &QTimer::timeout, this, [this]() {
     if (this->game->getGameState() == SnakeGame::GameState::Playing) 
     {
-        this->game->update();
+        this->game->advance();
+        if (!glBoard && this->game->getGameState() == SnakeGame::GameState::Playing) {
+            markMotionDirty();
+        }
     }
     });
-    // 食物动画定时器
-    connect(foodAnimationTimer, &QTimer::timeout, this, [this]() {
+    // 食物呼吸动画：只重绘食物所在的格子，精灵帧没有变化时不重绘
+    foodPulse = animations.add(FOOD_PULSE_MS, [this]() {
+        const int before = foodFrame();
+        foodScale = 0.9 + 0.1 * std::sin(foodRotation);
+        foodRotation += 0.1;
+        return foodFrame() == before ? QRegion() : QRegion(cellWidgetRect(this->game->getFood().getPosition()));
+    });
+    // 菜单预览食物的呼吸动画：与游戏中的食物共用相位，只重绘预览食物所在的区域
+    menuPulse = animations.add(FOOD_PULSE_MS, [this]() {
         foodScale = 0.9 + 0.1 * std::sin(foodRotation);
         foodRotation += 0.1;
+        return QRegion(MENU_FOOD_RECT.translated(menuPreviewOrigin())
+                           .adjusted(-DIRTY_MARGIN, -DIRTY_MARGIN, DIRTY_MARGIN, DIRTY_MARGIN));
+    });
+    updateAnimations();
+    connect(game, &SnakeGame::gameUpdated, this, &GameRenderer::onGameUpdated);
+    connect(game, &SnakeGame::gameOver, this, [this]() {
+        if (glBoard) syncBoardBackend();
+        updateAnimations();
         update();
     });
-    foodAnimationTimer->start(100);
-    connect(game, &SnakeGame::gameUpdated, this, QOverload<>::of(&QWidget::update));
-    connect(game, &SnakeGame::gameOver, this, QOverload<>::of(&QWidget::update));
     connect(game, &SnakeGame::stopGameTimer, this, &GameRenderer::stopGameTimer);
     connect(game, &SnakeGame::startGameTimer, this, &GameRenderer::startGameTimer);
-    gameTimer->start(120);
+    connect(game, &SnakeGame::boardSizeChanged, this, &GameRenderer::updateBoardGeometry);
+}
+void GameRenderer::updateBoardGeometry() {
+    const int boardWidth = game->getBoardWidth();
+    const int boardHeight = game->getBoardHeight();
+    const int longest = std::max(boardWidth, boardHeight);
+    boardScale = std::min(1.0, qreal(MAX_BOARD_PIXELS) / (longest * CELL_SIZE));
+    boardPixelWidth = qCeil(boardWidth * CELL_SIZE * boardScale);
+    boardPixelHeight = qCeil(boardHeight * CELL_SIZE * boardScale);
+    // 窗口宽度不小于默认值，保证菜单与分数栏的布局不变
+    setFixedSize(std::max(MAX_BOARD_PIXELS, boardPixelWidth), boardPixelHeight + 50);
+    if (glBoard) {
+        glBoard->setGeometry(0, 0, boardPixelWidth, boardPixelHeight);
+    }
+    invalidateLayers();
+    update();
+}
+void GameRenderer::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    invalidateLayers();
+}
+void GameRenderer::setBoardBackend(BoardBackend backend) {
+    if (backend == boardBackend()) return;
+    if (backend == PainterBackend) {
+        fallBackToPainter();
+        return;
+    }
+    glBoard = new GLBoardWidget(game, this);
+    glBoard->setGeometry(0, 0, boardPixelWidth, boardPixelHeight);
+    glBoard->setPalette(boardPalette());
+    glBoard->hide();
+    connect(glBoard, &GLBoardWidget::initializationFailed, this, [this]() {
+        qWarning("OpenGL 3.3 / ES 3.0 is not available, falling back to the QPainter board renderer");
+        fallBackToPainter();
+    });
+    syncBoardBackend();
+}
+// 食物动画只在蛇移动时播放：结束界面、等待第一次按键与暂停时画面静止，不再唤醒事件循环
+// OpenGL 后端的食物没有动画，也不需要播放；菜单显示时只播放预览食物的动画
+// 窗口隐藏、最小化或失去激活时两者都随调度器一起挂起
+void GameRenderer::updateAnimations() {
+    const bool moving = game->getGameState() == SnakeGame::GameState::Playing
+                        && !game->isWaitingForFirstMove() && !game->isPaused();
+    animations.setActive(foodPulse, moving && !glBoard);
+    animations.setActive(menuPulse, game->getGameState() == SnakeGame::GameState::Menu);
+}
+void GameRenderer::updateSuspension() {
+    animations.setSuspended(!isVisible() || isMinimized() || !isActiveWindow());
+}
+void GameRenderer::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    updateSuspension();
+}
+void GameRenderer::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+    game->pauseGame();
+    updateSuspension();
+}
+// 失去激活（切换到其他窗口）或最小化时自动暂停，回来后按 P / 空格继续
+void GameRenderer::changeEvent(QEvent* event) {
+    QWidget::changeEvent(event);
+    if (event->type() == QEvent::ActivationChange || event->type() == QEvent::WindowStateChange) {
+        if (isMinimized() || !isActiveWindow()) {
+            game->pauseGame();
+        }
+        updateSuspension();
+    }
+}
+// OpenGL 棋盘只在游戏进行中显示，菜单与结束界面仍由 QPainter 绘制整个窗口
+void GameRenderer::syncBoardBackend() {
+    const bool playing = game->getGameState() == SnakeGame::GameState::Playing;
+    if (glBoard->isVisible() != playing) {
+        glBoard->setVisible(playing);
+        update();
+    }
+}
+void GameRenderer::fallBackToPainter() {
+    if (!glBoard) return;
+    glBoard->hide();
+    glBoard->deleteLater();
+    glBoard = nullptr;
+    // QPainter 后端按局部重绘工作，先从当前局面重建蛇身编号并整屏重绘
+    rebuildSegmentSerials();
+    lastTick = game->getTickCount();
+    lastHead = game->getSnake().getHead();
+    lastFood = game->getFood().getPosition();
+    motionFrom = lastHead;
+    tailMoving = false;
+    update();
+}
+QVector<QColor> GameRenderer::boardPalette() const {
+    QVector<QColor> colors(InstancedBoardRenderer::PALETTE_SIZE);
+    colors[InstancedBoardRenderer::ObstacleCell] = QColor(100, 100, 100);
+    colors[InstancedBoardRenderer::FoodCell] = QColor(230, 80, 80);
+    colors[InstancedBoardRenderer::HeadCell] = snakeHeadColor;
+    for (int i = 0; i < InstancedBoardRenderer::BODY_COLORS; ++i) {
+        colors[InstancedBoardRenderer::BodyCell + i] = segmentBaseColor(i);
+    }
+    return colors;
 }
 void GameRenderer::stopGameTimer() {
     gameTimer->stop();
+    updateAnimations();
 }
 void GameRenderer::startGameTimer() {
-    int interval = 100;
-    switch (game->getDifficulty()) {
-        case 1: interval = 150; break;
-        case 2: interval = 100; break;
-        case 3: interval = 50; break;
-    }
-    gameTimer->start(interval);
+    // 定时器只决定显示帧率，游戏速度由 SnakeGame 的固定步长时钟保证
+    gameTimer->start(frameInterval());
+    updateAnimations();
+}
+int GameRenderer::frameInterval() const {
+    const QScreen* display = screen();
+    const qreal rate = display && display->refreshRate() > 0 ? display->refreshRate() : 60.0;
+    return std::max(1, qRound(1000.0 / rate));
 }
 void GameRenderer::paintEvent(QPaintEvent* event) {
-    Q_UNUSED(event);
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
     switch (game->getGameState()) {
@@ -71,12 +201,19 @@ void GameRenderer::paintEvent(QPaintEvent* event) {
             renderMenu(painter);
             break;
         case SnakeGame::GameState::Playing:
-            renderPlaying(painter);
+            renderPlaying(painter, event->region());
             break;
         case SnakeGame::GameState::GameOver:
             renderGameOver(painter);
             break;
     }
+    // 调试叠加层：用每次不同的半透明颜色覆盖本次重绘的区域
+    if (showRepaintRegions) {
+        const QColor flash = QColor::fromHsv((repaintFlash++ * 47) % 360, 255, 255, 70);
+        for (const QRect& dirty : event->region()) {
+            painter.fillRect(dirty, flash);
+        }
+    }
 }
 // 菜单渲染实现
 void GameRenderer::renderMenu(QPainter& painter) {
@@ -108,6 +245,8 @@ void GameRenderer::renderMenu(QPainter& painter) {
             addMenuItem(painter, "Select Appearance (A)", yPos, Qt::Key_A);
             yPos += lineHeight;
             addMenuItem(painter, "Select Map (M)", yPos, Qt::Key_M);
+            yPos += lineHeight;
+            addMenuItem(painter, QString("Autopilot: %1 (T)").arg(autopilotLabel()), yPos, Qt::Key_T);
             yPos += lineHeight * 2;
             addMenuItem(painter, "Quit (Q)", yPos, Qt::Key_Q);
             break;
@@ -160,7 +299,7 @@ void GameRenderer::renderMenu(QPainter& painter) {
             break;
     }
     // 预览
-    painter.translate(width()/2, height() - 100);
+    painter.translate(menuPreviewOrigin());
     painter.setRenderHint(QPainter::Antialiasing);
     
     // 绘制预览蛇
@@ -173,71 +312,73 @@ void GameRenderer::renderMenu(QPainter& painter) {
     QRect headRect(15, 0, 20, 20);
     drawSnakeHead(painter, headRect, QPoint(1, 0));
     
-    // 绘制食物
-    QRect foodRect(60, 0, 20, 20);
-    drawFood(painter, foodRect);
+    // 绘制食物（呼吸动画由 menuPulse 推进）
+    drawFood(painter, MENU_FOOD_RECT);
     
     painter.resetTransform();
 }
 // 游戏进行界面
-void GameRenderer::renderPlaying(QPainter& painter) {
+void GameRenderer::renderPlaying(QPainter& painter, const QRegion& region) {
     painter.setRenderHint(QPainter::Antialiasing);
-    // 背景
-    QLinearGradient bgGradient(0, 0, width(), height());
-    bgGradient.setColorAt(0, QColor(40, 40, 60));
-    bgGradient.setColorAt(1, QColor(20, 20, 30));
-    painter.fillRect(rect(), bgGradient);
-    // 网格
-    painter.setPen(QPen(QColor(60, 60, 80, 100), 1));
-    for (int x = 0; x <= GRID_WIDTH; ++x)
-        painter.drawLine(x * CELL_SIZE, 0, x * CELL_SIZE, GRID_HEIGHT * CELL_SIZE);
-    for (int y = 0; y <= GRID_HEIGHT; ++y)
-        painter.drawLine(0, y * CELL_SIZE, GRID_WIDTH * CELL_SIZE, y * CELL_SIZE);
-    // 蛇身
-    const auto& body = game->getSnake().getBody();
-    for (size_t i = 1; i < body.size(); ++i) {
-        QRect segmentRect(
-            body[i].x() * CELL_SIZE,
-            body[i].y() * CELL_SIZE,
-            CELL_SIZE, CELL_SIZE
-        );
-        drawSnakeSegment(painter, segmentRect, i, body.size());
-    }
-    // 障碍物
-    const auto& obstacles = game->getObstacles();
-    for (const QPoint& obstacle : obstacles) {
-        QRect obstacleRect(
-            obstacle.x() * CELL_SIZE,
-            obstacle.y() * CELL_SIZE,
-            CELL_SIZE, CELL_SIZE
-        );
-        drawObstacle(painter, obstacleRect);
-    }
-    // 蛇头
-    if (!body.empty()) {
-        QPoint headPos = body[0];
-        QRect headRect(
-            headPos.x() * CELL_SIZE,
-            headPos.y() * CELL_SIZE,
-            CELL_SIZE, CELL_SIZE
-        );
-        QPoint direction;
-    switch(game->getSnake().getDirection()) {
-        case Snake::Up:    direction = QPoint(0, -1); break;
-        case Snake::Down:  direction = QPoint(0, 1); break;
-        case Snake::Left:  direction = QPoint(-1, 0); break;
-        case Snake::Right: direction = QPoint(1, 0); break;
-}
-        drawSnakeHead(painter, headRect, direction);
-    }
-    // 食物
-    QPoint foodPos = game->getFood().getPosition();
-    QRect foodRect(
-        foodPos.x() * CELL_SIZE,
-        foodPos.y() * CELL_SIZE,
-        CELL_SIZE, CELL_SIZE
-    );
-    drawFood(painter, foodRect);
+    // 背景、网格与障碍物来自预先渲染的静态图层，只复制需要重绘的区域
+    ensureBoardLayer();
+    blitLayer(painter, boardLayer, region);
+    if (!glBoard) {
+        ensureSprites();
+        renderBoard(painter, region);
+    }
+    if (game->isPaused() && !glBoard) {
+        renderPauseOverlay(painter);
+    }
+    renderScoreBar(painter);
+}
+void GameRenderer::renderPauseOverlay(QPainter& painter) {
+    const QRect board(0, 0, boardPixelWidth, boardPixelHeight);
+    painter.fillRect(board, QColor(0, 0, 0, 120));
+    painter.setFont(QFont("Arial", 24, QFont::Bold));
+    painter.setPen(QColor(220, 220, 255));
+    painter.drawText(board, Qt::AlignCenter, "PAUSED\nPress P or Space to continue");
+}
+// 用 QPainter 绘制棋盘上的动态内容（OpenGL 后端启用时由 GLBoardWidget 代替）
+void GameRenderer::renderBoard(QPainter& painter, const QRegion& region) {
+    // 棋盘内容按逻辑坐标绘制，整体缩放到窗口
+    const Snake::BodyView body = game->getSnake().getBody();
+    painter.save();
+    painter.scale(boardScale, boardScale);
+    // 把重绘区域换算成格子范围：范围内的格子数少于蛇身节数时逐格绘制，
+    // 这样每帧只重绘几个格子时的开销与蛇的长度无关；整屏重绘时仍按列表遍历
+    QList<QRect> cellRanges;
+    qint64 dirtyCells = 0;
+    for (const QRect& dirty : region) {
+        const QRect cells = cellRangeFor(dirty);
+        if (cells.isEmpty()) continue;
+        cellRanges.append(cells);
+        dirtyCells += static_cast<qint64>(cells.width()) * cells.height();
+    }
+    if (dirtyCells < static_cast<qint64>(body.size())) {
+        for (const QRect& cells : cellRanges) {
+            drawBoardCells(painter, cells);
+        }
+        // 移动中的蛇头、蛇尾跨越两个格子，在逐格绘制之后各画一次
+        drawSlidingTail(painter);
+        drawSnakeHeadCell(painter);
+    } else {
+        // 蛇身：所有节合并为一次 drawPixmapFragments 调用
+        QVector<QPainter::PixmapFragment> fragments;
+        fragments.reserve(static_cast<int>(body.size()));
+        for (size_t i = 1; i < body.size(); ++i) {
+            const QRect rect = cellRect(body[i]);
+            fragments.append(sprites.fragment(bodySprite(body[i]), QRectF(rect).center(), sprites.spriteSize()));
+        }
+        sprites.drawFragments(painter, fragments);
+        drawSlidingTail(painter);
+        drawSnakeHeadCell(painter);
+        drawFoodCell(painter);
+    }
+    painter.restore();
+}
+// 分数栏：分数和时间
+void GameRenderer::renderScoreBar(QPainter& painter) {
     // 分数和时间
     painter.setPen(QColor(220, 220, 255));
     painter.setFont(QFont("Arial", 14, QFont::Bold));
@@ -245,47 +386,299 @@ void GameRenderer::renderPlaying(QPainter& painter) {
     // 分数背景
     painter.setBrush(QColor(30, 30, 50, 200));
     painter.setPen(Qt::NoPen);
-    painter.drawRoundedRect(10, GRID_HEIGHT * CELL_SIZE + 10, 120, 30, 5, 5);
+    painter.drawRoundedRect(10, boardPixelHeight + 10, 120, 30, 5, 5);
     
     // 时间背景
-    painter.drawRoundedRect(width() - 130, GRID_HEIGHT * CELL_SIZE + 10, 120, 30, 5, 5);
+    painter.drawRoundedRect(width() - 130, boardPixelHeight + 10, 120, 30, 5, 5);
     
     // 分数文本
     painter.setPen(QColor(255, 215, 100));
-    painter.drawText(20, GRID_HEIGHT * CELL_SIZE + 30, 
+    painter.drawText(20, boardPixelHeight + 30, 
                     QString("Score: %1").arg(game->getScore()));
     
     // 时间文本
-    painter.drawText(width() - 120, GRID_HEIGHT * CELL_SIZE + 30, 
+    painter.drawText(width() - 120, boardPixelHeight + 30, 
                     QString("Time: %1s").arg(game->getElapsedTime()));
+
+    // 调试信息（F3）：本局逻辑帧的平均 / 最大抖动，迟到与丢弃的帧数，
+    // 以及按键到转向的延迟 p50 / p99 与被推迟到后续帧的输入数；暂停时这里改为显示暂停提示
+    if (game->isPaused()) {
+        painter.setFont(QFont("Arial", 12, QFont::Bold));
+        painter.setPen(QColor(255, 215, 100));
+        painter.drawText(QRect(140, boardPixelHeight + 10, width() - 280, 30), Qt::AlignCenter, "PAUSED (P)");
+    } else if (showRepaintRegions) {
+        const SimulationThread::TickStats& stats = game->getTickStats();
+        const SimulationThread::InputStats& input = game->getInputStats();
+        painter.setFont(QFont("Arial", 9));
+        painter.setPen(QColor(180, 180, 220));
+        painter.drawText(QRect(140, boardPixelHeight + 10, width() - 280, 30), Qt::AlignCenter,
+                         QString("jitter %1/%2 ms, late %3, dropped %4\n"
+                                 "input p50 %5 ms, p99 %6 ms, deferred %7/%8")
+                             .arg(stats.meanJitterNanos() / 1e6, 0, 'f', 2)
+                             .arg(stats.maxJitterNanos / 1e6, 0, 'f', 2)
+                             .arg(stats.lateTicks)
+                             .arg(stats.droppedTicks)
+                             .arg(input.latency.percentile(50) / 1e6, 0, 'f', 0)
+                             .arg(input.latency.percentile(99) / 1e6, 0, 'f', 0)
+                             .arg(input.deferredTurns)
+                             .arg(input.latency.count()));
+    } else if (game->isAutopilot()) {
+        painter.setFont(QFont("Arial", 12, QFont::Bold));
+        painter.setPen(QColor(150, 200, 255));
+        painter.drawText(QRect(140, boardPixelHeight + 10, width() - 280, 30), Qt::AlignCenter,
+                         QString("AUTOPILOT: %1 (T)").arg(autopilotLabel()));
+    }
 }
-// 游戏结束界面
-void GameRenderer::renderGameOver(QPainter& painter) {
+// 逐格绘制 cells 范围内的动态内容（蛇身、蛇头、食物；网格与障碍物已在静态图层中）
+void GameRenderer::drawBoardCells(QPainter& painter, const QRect& cells) {
+    const Snake& snake = game->getSnake();
+    const QPoint head = snake.getHead();
+    for (int y = cells.top(); y <= cells.bottom(); ++y) {
+        for (int x = cells.left(); x <= cells.right(); ++x) {
+            const QPoint cell(x, y);
+            if (cell != head && snake.isOccupied(cell)) {
+                sprites.draw(painter, bodySprite(cell), spriteRect(cell));
+            }
+        }
+    }
+    if (cells.contains(game->getFood().getPosition())) {
+        drawFoodCell(painter);
+    }
+}
+// 绘制 cells 范围内的网格线（格子太小时省略，否则只剩一片线条）
+void GameRenderer::drawGridLines(QPainter& painter, const QRect& cells) {
+    if (CELL_SIZE * boardScale < MIN_GRID_LINE_PIXELS) return;
+    painter.setPen(QPen(QColor(60, 60, 80, 100), 0));
+    for (int x = cells.left(); x <= cells.right() + 1; ++x)
+        painter.drawLine(x * CELL_SIZE, cells.top() * CELL_SIZE, x * CELL_SIZE, (cells.bottom() + 1) * CELL_SIZE);
+    for (int y = cells.top(); y <= cells.bottom() + 1; ++y)
+        painter.drawLine(cells.left() * CELL_SIZE, y * CELL_SIZE, (cells.right() + 1) * CELL_SIZE, y * CELL_SIZE);
+}
+// 创建与窗口同尺寸、按设备像素比放大的图层（高分屏上不会模糊），先填充窗口底色
+QPixmap GameRenderer::createLayer() const {
+    const qreal dpr = devicePixelRatioF();
+    QPixmap layer(qCeil(width() * dpr), qCeil(height() * dpr));
+    layer.setDevicePixelRatio(dpr);
+    layer.fill(QColor(30, 30, 40));
+    return layer;
+}
+// 把图层中与 region 对应的部分复制到窗口（每个矩形一次调用）
+void GameRenderer::blitLayer(QPainter& painter, const QPixmap& layer, const QRegion& region) {
+    const qreal dpr = layer.devicePixelRatio();
+    for (const QRect& dirty : region) {
+        painter.drawPixmap(QRectF(dirty), layer,
+                           QRectF(dirty.x() * dpr, dirty.y() * dpr, dirty.width() * dpr, dirty.height() * dpr));
+    }
+}
+// 丢弃静态图层（窗口尺寸、地图尺寸或障碍物改变时调用），下次绘制时重新生成
+void GameRenderer::invalidateLayers() {
+    boardLayer = QPixmap();
+    gameOverLayer = QPixmap();
+}
+// 游戏界面静态图层：渐变背景 + 网格 + 障碍物（障碍物在开局后不再移动）
+void GameRenderer::ensureBoardLayer() {
+    if (!boardLayer.isNull() && boardLayer.devicePixelRatio() == devicePixelRatioF()) return;
+    boardLayer = createLayer();
+    QPainter layerPainter(&boardLayer);
+    layerPainter.setRenderHint(QPainter::Antialiasing);
+    QLinearGradient bgGradient(0, 0, width(), height());
+    bgGradient.setColorAt(0, QColor(40, 40, 60));
+    bgGradient.setColorAt(1, QColor(20, 20, 30));
+    layerPainter.fillRect(rect(), bgGradient);
+    layerPainter.scale(boardScale, boardScale);
+    drawGridLines(layerPainter, QRect(0, 0, game->getBoardWidth(), game->getBoardHeight()));
+    for (const QPoint& obstacle : game->getObstacles()) {
+        drawObstacle(layerPainter, cellRect(obstacle));
+    }
+}
+// 游戏结束界面静态图层：半透明渐变 + 斜纹纹理
+void GameRenderer::ensureGameOverLayer() {
+    if (!gameOverLayer.isNull() && gameOverLayer.devicePixelRatio() == devicePixelRatioF()) return;
+    gameOverLayer = createLayer();
+    QPainter layerPainter(&gameOverLayer);
     QLinearGradient gradient(0, 0, width(), height());
     gradient.setColorAt(0, QColor(120, 0, 0, 220));
     gradient.setColorAt(1, QColor(60, 0, 60, 220));
-    painter.fillRect(rect(), gradient);
+    layerPainter.fillRect(rect(), gradient);
     // 纹理效果
-    painter.setPen(QPen(QColor(255, 255, 255, 30), 2));
-    for (int x = 0; x < width(); x += 30) painter.drawLine(x, 0, x, height());
-    for (int y = 0; y < height(); y += 30) painter.drawLine(0, y, width(), y);
-    // 游戏结束文字
+    layerPainter.setPen(QPen(QColor(255, 255, 255, 30), 2));
+    for (int x = 0; x < width(); x += 30) layerPainter.drawLine(x, 0, x, height());
+    for (int y = 0; y < height(); y += 30) layerPainter.drawLine(0, y, width(), y);
+}
+void GameRenderer::drawSnakeHeadCell(QPainter& painter) {
+    const Snake& snake = game->getSnake();
+    if (snake.getLength() == 0) return;
+    sprites.draw(painter, BODY_SPRITES + snake.getDirection(), spriteRect(interpolate(motionFrom, snake.getHead())));
+}
+void GameRenderer::drawSlidingTail(QPainter& painter) {
+    const Snake& snake = game->getSnake();
+    if (!tailMoving || snake.getLength() < 2) return;
+    // 离开的一节比当前蛇尾早一个编号，颜色保持不变
+    const QPoint tail = snake.getBody().back();
+    const int sprite = (bodySprite(tail) + BODY_SPRITES - 1) % BODY_SPRITES;
+    sprites.draw(painter, sprite, spriteRect(interpolate(tailFrom, tail)));
+}
+QPointF GameRenderer::interpolate(const QPoint& from, const QPoint& to) const {
+    const qreal alpha = game->getInterpolation();
+    return QPointF(from) + QPointF(to - from) * alpha;
+}
+void GameRenderer::markMotionDirty() {
+    const Snake& snake = game->getSnake();
+    update(cellWidgetRect(motionFrom));
+    update(cellWidgetRect(snake.getHead()));
+    if (tailMoving && snake.getLength() >= 2) {
+        update(cellWidgetRect(tailFrom));
+        update(cellWidgetRect(snake.getBody().back()));
+    }
+}
+int GameRenderer::foodFrame() const {
+    return static_cast<int>(std::fmod(foodRotation, TWO_PI) / TWO_PI * FOOD_FRAMES) % FOOD_FRAMES;
+}
+void GameRenderer::drawFoodCell(QPainter& painter) {
+    // 按当前动画相位选取预渲染的食物帧
+    const int frame = foodFrame();
+    sprites.draw(painter, BODY_SPRITES + HEAD_SPRITES + frame, spriteRect(game->getFood().getPosition()));
+}
+// 精灵在棋盘逻辑坐标中的绘制区域（格子四周各留 SPRITE_PADDING）
+QRectF GameRenderer::spriteRect(const QPoint& cell) const {
+    return QRectF(cellRect(cell)).adjusted(-SPRITE_PADDING, -SPRITE_PADDING, SPRITE_PADDING, SPRITE_PADDING);
+}
+QRectF GameRenderer::spriteRect(const QPointF& cell) const {
+    return QRectF(cell.x() * CELL_SIZE - SPRITE_PADDING, cell.y() * CELL_SIZE - SPRITE_PADDING,
+                  CELL_SIZE + 2 * SPRITE_PADDING, CELL_SIZE + 2 * SPRITE_PADDING);
+}
+// 蛇身格子对应的精灵（由该节的编号决定颜色）
+int GameRenderer::bodySprite(const QPoint& cell) const {
+    return static_cast<int>(segmentSerials.value(cellKey(cell)) % BODY_SPRITES);
+}
+// 按当前配色、蛇头形状和棋盘缩放生成精灵图集（已是最新时直接返回）
+// 图集内容：BODY_SPRITES 种蛇身、HEAD_SPRITES 个方向的蛇头、FOOD_FRAMES 帧食物动画
+void GameRenderer::ensureSprites() {
+    const int spriteSize = CELL_SIZE + 2 * SPRITE_PADDING;
+    const int pixelSize = std::max(2, qCeil(spriteSize * boardScale * devicePixelRatioF()));
+    if (!sprites.isNull() && spritePixelSize == pixelSize) return;
+    spritePixelSize = pixelSize;
+    sprites.reset(BODY_SPRITES + HEAD_SPRITES + FOOD_FRAMES, spriteSize, pixelSize);
+    const QRect cell(SPRITE_PADDING, SPRITE_PADDING, CELL_SIZE, CELL_SIZE);
+    for (int i = 0; i < BODY_SPRITES; ++i) {
+        sprites.render(i, [&](QPainter& painter) { drawSnakeSegment(painter, cell, i, 0); });
+    }
+    const QPoint directions[HEAD_SPRITES] = {QPoint(0, -1), QPoint(0, 1), QPoint(-1, 0), QPoint(1, 0)};
+    for (int i = 0; i < HEAD_SPRITES; ++i) {
+        sprites.render(BODY_SPRITES + i, [&](QPainter& painter) { drawSnakeHead(painter, cell, directions[i]); });
+    }
+    for (int i = 0; i < FOOD_FRAMES; ++i) {
+        sprites.render(BODY_SPRITES + HEAD_SPRITES + i, [&](QPainter& painter) {
+            drawFoodFrame(painter, cell, i * TWO_PI / FOOD_FRAMES);
+        });
+    }
+}
+// 格子在棋盘逻辑坐标中的矩形
+QRect GameRenderer::cellRect(const QPoint& cell) const {
+    return QRect(cell.x() * CELL_SIZE, cell.y() * CELL_SIZE, CELL_SIZE, CELL_SIZE);
+}
+// 格子在窗口像素坐标中的矩形（向外留出 DIRTY_MARGIN，覆盖蛇头、食物动画等略超出格子的部分）
+// 菜单预览（蛇与食物）的原点，位于窗口底部中央
+QPoint GameRenderer::menuPreviewOrigin() const {
+    return QPoint(width() / 2, height() - 100);
+}
+QRect GameRenderer::cellWidgetRect(const QPoint& cell) const {
+    const qreal size = CELL_SIZE * boardScale;
+    return QRect(qFloor(cell.x() * size), qFloor(cell.y() * size), qCeil(size) + 1, qCeil(size) + 1)
+        .adjusted(-DIRTY_MARGIN, -DIRTY_MARGIN, DIRTY_MARGIN, DIRTY_MARGIN);
+}
+// 与窗口像素矩形相交的格子范围（已截断到地图内）
+QRect GameRenderer::cellRangeFor(const QRect& widgetRect) const {
+    const qreal size = CELL_SIZE * boardScale;
+    const QRect range(QPoint(qFloor(widgetRect.left() / size), qFloor(widgetRect.top() / size)),
+                      QPoint(qFloor(widgetRect.right() / size), qFloor(widgetRect.bottom() / size)));
+    return range.intersected(QRect(0, 0, game->getBoardWidth(), game->getBoardHeight()));
+}
+// 每个逻辑帧之后：只把发生变化的格子（新蛇头、旧蛇头、空出的蛇尾、新旧食物）和分数栏标记为需要重绘
+void GameRenderer::onGameUpdated() {
+    if (glBoard) {
+        // OpenGL 后端：棋盘每帧整体重绘（一次实例化绘制），窗口本身只需刷新分数栏
+        syncBoardBackend();
+        glBoard->update();
+        update(QRect(0, boardPixelHeight, width(), height() - boardPixelHeight));
+        return;
+    }
+    const Snake& snake = game->getSnake();
+    const quint64 tick = game->getTickCount();
+    if (game->getGameState() != SnakeGame::GameState::Playing || game->isPaused() || tick != lastTick + 1) {
+        // 新开局、状态切换、暂停 / 继续或跳过了若干帧：重新编号蛇身并整屏重绘
+        // 新开局可能换了障碍物，静态图层也一并重建
+        rebuildSegmentSerials();
+        if (tick == 0) {
+            invalidateLayers();
+        }
+        lastTick = tick;
+        lastHead = snake.getHead();
+        lastFood = game->getFood().getPosition();
+        motionFrom = lastHead;
+        tailMoving = false;
+        update();
+        return;
+    }
+    lastTick = tick;
+    // 上一逻辑帧的插值位置可能还残留在这些格子上
+    update(cellWidgetRect(motionFrom));
+    if (tailMoving) {
+        update(cellWidgetRect(tailFrom));
+    }
+    motionFrom = lastHead;
+    tailMoving = snake.hasVacatedTail();
+    tailFrom = snake.getVacatedTail();
+    if (snake.hasVacatedTail()) {
+        segmentSerials.remove(cellKey(snake.getVacatedTail()));
+        update(cellWidgetRect(snake.getVacatedTail()));
+    }
+    if (snake.getOccupancy().contains(snake.getHead())) {
+        segmentSerials.insert(cellKey(snake.getHead()), ++nextSerial);
+    }
+    update(cellWidgetRect(snake.getHead()));
+    update(cellWidgetRect(lastHead));
+    update(cellWidgetRect(lastFood));
+    update(cellWidgetRect(game->getFood().getPosition()));
+    update(QRect(0, boardPixelHeight, width(), height() - boardPixelHeight));
+    lastHead = snake.getHead();
+    lastFood = game->getFood().getPosition();
+}
+// 按蛇尾到蛇头的顺序重新给蛇身各节分配编号（编号决定颜色，之后每节的颜色保持不变）
+void GameRenderer::rebuildSegmentSerials() {
+    const Snake::BodyView body = game->getSnake().getBody();
+    segmentSerials.clear();
+    nextSerial = 0;
+    for (size_t i = body.size(); i-- > 0;) {
+        segmentSerials.insert(cellKey(body[i]), ++nextSerial);
+    }
+}
+// 游戏结束界面
+void GameRenderer::renderGameOver(QPainter& painter) {
+    // 渐变背景与纹理来自缓存图层，一次复制完成
+    ensureGameOverLayer();
+    painter.drawPixmap(0, 0, gameOverLayer);
+    // 游戏结束文字（填满地图时显示获胜，重放结束状态与录像不一致时显示不同步）
     painter.setFont(QFont("Arial", 28, QFont::Bold));
     QRect textRect = rect().adjusted(0, 50, 0, 0);
+    const bool boardComplete = game->isBoardComplete();
+    const QString title = !game->isReplayConsistent() ? "REPLAY DESYNC"
+                          : boardComplete             ? "BOARD COMPLETE!"
+                                                      : "GAME OVER";
     
     // 阴影
     painter.setPen(QColor(0, 0, 0, 150));
-    painter.drawText(textRect.translated(2, 2), Qt::AlignTop | Qt::AlignHCenter, "GAME OVER");
+    painter.drawText(textRect.translated(2, 2), Qt::AlignTop | Qt::AlignHCenter, title);
     
     // 前景
-    painter.setPen(QColor(255, 100, 100));
-    painter.drawText(textRect, Qt::AlignTop | Qt::AlignHCenter, "GAME OVER");
+    painter.setPen(boardComplete ? QColor(255, 215, 0) : QColor(255, 100, 100));
+    painter.drawText(textRect, Qt::AlignTop | Qt::AlignHCenter, title);
     // 分数信息
     painter.setFont(QFont("Arial", 18));
     QRect infoRect = textRect.adjusted(0, 80, 0, 0);
     QStringList infoText = {
         QString("Score: %1").arg(game->getScore()),
-        QString("Time: %1s").arg(game->getElapsedTime()),
+        QString("Time: %1s").arg(game->getElapsedMillis() / 1000.0, 0, 'f', 2),
         game->getScore() > game->getHighScore() ? 
             "NEW HIGH SCORE!" : 
             QString("High Score: %1").arg(game->getHighScore())
@@ -298,6 +691,17 @@ void GameRenderer::renderGameOver(QPainter& painter) {
                       QColor(255, 215, 0) : QColor(200, 200, 255));
         painter.drawText(lineRect, Qt::AlignHCenter | Qt::AlignTop, infoText[i]);
     }
+    // 当前地图与难度排行榜的前几名（本局名次高亮）
+    const std::vector<LeaderboardStore::Entry> leaders = game->getLeaderboard();
+    painter.setFont(QFont("Arial", 11));
+    const int shown = std::min(static_cast<int>(leaders.size()), LEADERBOARD_LINES);
+    for (int i = 0; i < shown; ++i) {
+        QRect lineRect = infoRect.adjusted(0, infoText.size() * 40 + 10 + i * 18, 0, 0);
+        painter.setPen(i + 1 == game->getLeaderboardRank() ? QColor(255, 215, 0) : QColor(170, 170, 210));
+        painter.drawText(lineRect, Qt::AlignHCenter | Qt::AlignTop,
+                         QString("#%1   %2   %3s").arg(i + 1).arg(leaders[i].score)
+                             .arg(leaders[i].timeMillis / 1000.0, 0, 'f', 1));
+    }
     // 操作按钮
     QRect resetRect(width()/2 - 100, height() - 120, 200, 40);
     painter.setBrush(QColor(80, 80, 80, 200));
@@ -342,6 +746,10 @@ void GameRenderer::handleMenuKeyPress(int key) {
                     currentMenuState = MapMenu;
                     update();
                     break;
+                case Qt::Key_T:
+                    cycleAutopilot();
+                    update();
+                    break;
                 case Qt::Key_Q:
                     qApp->quit();
                     break;
@@ -372,6 +780,7 @@ void GameRenderer::handleMenuKeyPress(int key) {
                 case Qt::Key_H:
                     selectedHeadShape = static_cast<HeadShape>(
                         (selectedHeadShape + 1) % 4);
+                    sprites.clear(); // 蛇头形状改变，精灵需要重新生成
                     update();
                     break;
                 case Qt::Key_C:
@@ -410,8 +819,44 @@ void GameRenderer::handlePlayingKeyPress(int key) {
     // 同时，我们也需要处理ESC键
     if (key == Qt::Key_Escape) {
         game->setGameState(SnakeGame::GameState::Menu);
+        if (glBoard) syncBoardBackend();
+        updateAnimations();
+    }
+    // P / 空格：暂停或继续
+    if (key == Qt::Key_P || key == Qt::Key_Space) {
+        if (game->isPaused()) {
+            game->resumeGame();
+        } else {
+            game->pauseGame();
+        }
+    }
+    // T：切换自动驾驶模式（关闭后由玩家从当前局面接手）
+    if (key == Qt::Key_T) {
+        cycleAutopilot();
+        update();
+    }
+    // F3：开关重绘区域调试叠加层
+    if (key == Qt::Key_F3) {
+        showRepaintRegions = !showRepaintRegions;
+        update();
+    }
+}
+void GameRenderer::cycleAutopilot() {
+    if (!game->isAutopilot()) {
+        game->setAutopilotStrategy(Autopilot::PathStrategy);
+        game->setAutopilot(true);
+    } else if (game->getAutopilotStrategy() == Autopilot::PathStrategy) {
+        game->setAutopilotStrategy(Autopilot::CycleStrategy);
+    } else {
+        game->setAutopilot(false);
     }
 }
+QString GameRenderer::autopilotLabel() const {
+    if (!game->isAutopilot()) return "Off";
+    if (game->getAutopilotStrategy() == Autopilot::PathStrategy) return "A*";
+    // 地图上构造不出哈密顿回路（有障碍物或两边都是奇数）时实际由 A* 驾驶
+    return game->getGameState() == SnakeGame::GameState::Playing && !game->isAutopilotOnCycle() ? "Cycle -> A*" : "Cycle";
+}
 void GameRenderer::handleGameOverKeyPress(int key) {
     switch (key) {
         case Qt::Key_R:
@@ -581,29 +1026,30 @@ void GameRenderer::drawEyes(QPainter& painter, const QPoint& offset) {
     painter.drawEllipse(offset + QPoint(4, 4), 1, 1);
 }
 
+QColor GameRenderer::segmentBaseColor(int segmentSerial) const {
+    // 彩虹色处理
+    if (selectedBodyColor == RainbowBody) {
+        // 根据编号计算彩虹色（编号随蛇身一起移动，不随蛇头位置变化）
+        float hue = (segmentSerial % 10) * 36.0f; // 每段不同颜色
+        return QColor::fromHsv(hue, 200, 200);
+    }
+    // 基础颜色（交替深浅）
+    QColor baseColor = snakeBodyColor;
+    if (segmentSerial % 2 == 0) {
+        baseColor = baseColor.lighter(110);
+    }
+    return baseColor;
+}
 void GameRenderer::drawSnakeSegment(QPainter& painter,
                                   const QRect& rect,
-                                  int segmentIndex,
+                                  int segmentSerial,
                                   int totalSegments)
 {
     Q_UNUSED(totalSegments); // 显式标记未使用的参数
     painter.save();
     painter.setRenderHint(QPainter::Antialiasing);
     
-    QColor baseColor;
-    
-    // 彩虹色处理
-    if (selectedBodyColor == RainbowBody) {
-        // 根据位置计算彩虹色
-        float hue = (segmentIndex % 10) * 36.0f; // 每段不同颜色
-        baseColor = QColor::fromHsv(hue, 200, 200);
-    } else {
-        // 基础颜色（交替深浅）
-        baseColor = snakeBodyColor;
-        if (segmentIndex % 2 == 0) {
-            baseColor = baseColor.lighter(110);
-        }
-    }
+    const QColor baseColor = segmentBaseColor(segmentSerial);
     
     // 创建渐变效果
     QLinearGradient bodyGradient(rect.topLeft(), rect.bottomRight());
@@ -624,6 +1070,9 @@ void GameRenderer::drawSnakeSegment(QPainter& painter,
     painter.restore();
 }
 void GameRenderer::drawFood(QPainter& painter, const QRect& rect) {
+    drawFoodFrame(painter, rect, foodRotation);
+}
+void GameRenderer::drawFoodFrame(QPainter& painter, const QRect& rect, qreal rotation) {
     painter.save();
     painter.setRenderHint(QPainter::Antialiasing);
     
@@ -632,7 +1081,7 @@ void GameRenderer::drawFood(QPainter& painter, const QRect& rect) {
     path.addEllipse(rect);
     
     // 动画效果（呼吸效果）
-    qreal scaleFactor = 0.8 + 0.2 * std::sin(foodRotation);
+    qreal scaleFactor = 0.8 + 0.2 * std::sin(rotation);
     painter.translate(rect.center());
     painter.scale(scaleFactor, scaleFactor);
     painter.translate(-rect.center());
@@ -665,6 +1114,7 @@ void GameRenderer::drawObstacle(QPainter& painter, const QRect& rect) {
     painter.drawLine(rect.left() + 5, rect.bottom() - 5, rect.right() - 5, rect.top() + 5);
 }
 void GameRenderer::updateSnakeColors() {
+    sprites.clear(); // 配色改变，精灵需要重新生成
     switch (selectedBodyColor) {
         case GreenBody:
             snakeHeadColor = QColor(100, 200, 100);
@@ -683,6 +1133,9 @@ void GameRenderer::updateSnakeColors() {
             snakeBodyColor = QColor(150, 0, 0); // 基础颜色，但会被彩虹色覆盖
             break;
     }
+    if (glBoard) {
+        glBoard->setPalette(boardPalette());
+    }
 }
 // 新增现代圆形蛇头绘制方法
 void GameRenderer::drawHexagonHead(QPainter& painter, const QPoint& direction) {
@@ -8,7 +8,15 @@
 #include <QRadialGradient>
 #include <QList>
 #include <QMouseEvent>
+#include <QHash>
+#include <QRegion>
+#include <QPixmap>
+#include <QResizeEvent>
+#include "AnimationScheduler.h"
 #include "SnakeGame.h"
+#include "SpriteAtlas.h"
+
+class GLBoardWidget;
 
 // 枚举：蛇体颜色类型（用于自定义皮肤）
 enum SnakeBodyColor {
@@ -66,6 +74,16 @@ public:
     // 更新蛇颜色样式（响应用户设置）
     void updateSnakeColors();
 
+    // 根据地图尺寸重新计算棋盘缩放比例与窗口大小（地图尺寸改变时调用）
+    void updateBoardGeometry();
+
+    // 棋盘绘制后端：QPainter（默认）或 OpenGL 实例化绘制（大地图时更快）
+    enum BoardBackend { PainterBackend, OpenGLBackend };
+
+    // 选择棋盘绘制后端（启动时调用；OpenGL 初始化失败时自动回退到 QPainter）
+    void setBoardBackend(BoardBackend backend);
+    BoardBackend boardBackend() const { return glBoard ? OpenGLBackend : PainterBackend; }
+
 protected:
     // Qt事件：窗口绘制
     void paintEvent(QPaintEvent* event) override;
@@ -76,6 +94,14 @@ protected:
     // Qt事件：鼠标点击处理
     void mousePressEvent(QMouseEvent* event) override;
 
+    // Qt事件：窗口尺寸改变（静态图层需要重建）
+    void resizeEvent(QResizeEvent* event) override;
+
+    // Qt事件：窗口显示 / 隐藏、最小化与激活状态改变（挂起动画，失去焦点时暂停游戏）
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
+    void changeEvent(QEvent* event) override;
+
 private:
     // === 蛇头绘制函数 ===
     void drawCircleHead(QPainter& painter);
@@ -87,26 +113,75 @@ private:
     void drawEyes(QPainter& painter, const QPoint& offset);
 
     // === 蛇体绘制函数 ===
-    void drawSnakeSegment(QPainter& painter, const QRect& segmentRect, int segmentIndex, int totalSegments);
+    void drawSnakeSegment(QPainter& painter, const QRect& segmentRect, int segmentSerial, int totalSegments);
     void drawSnakeHead(QPainter& painter, const QRect& headRect, const QPoint& direction);
 
     // === 其他元素绘制 ===
     void drawFood(QPainter& painter, const QRect& foodRect);
+    void drawFoodFrame(QPainter& painter, const QRect& foodRect, qreal rotation); // 指定动画相位
     void drawObstacle(QPainter& painter, const QRect& obstacleRect);
 
+    // === 棋盘局部重绘 ===
+    void onGameUpdated();                                    // 每个逻辑帧后只标记变化的格子
+    void rebuildSegmentSerials();                            // 重新给蛇身各节编号（新开局或跳帧时）
+    void drawBoardCells(QPainter& painter, const QRect& cells); // 逐格绘制一个格子范围
+    void drawGridLines(QPainter& painter, const QRect& cells);
+    void drawSnakeHeadCell(QPainter& painter);              // 蛇头（在上一帧与本帧的位置之间插值）
+    void drawSlidingTail(QPainter& painter);                 // 离开中的蛇尾（从空出的格子滑向新的尾部）
+    void drawFoodCell(QPainter& painter);
+    int foodFrame() const;                                   // 当前动画相位对应的食物精灵帧
+    void markMotionDirty();                                  // 标记插值移动经过的格子（每个显示帧调用）
+    QPointF interpolate(const QPoint& from, const QPoint& to) const; // 按当前插值系数取两格之间的位置
+    int frameInterval() const;                               // 屏幕刷新间隔（毫秒）
+    QRect cellRect(const QPoint& cell) const;                // 格子的棋盘逻辑坐标矩形
+    QRect cellWidgetRect(const QPoint& cell) const;          // 格子的窗口像素矩形（含边距）
+    QPoint menuPreviewOrigin() const;                        // 菜单预览的原点（窗口坐标）
+    QRect cellRangeFor(const QRect& widgetRect) const;       // 窗口矩形覆盖的格子范围
+    int cellKey(const QPoint& cell) const { return cell.y() * game->getBoardWidth() + cell.x(); }
+
+    // === 静态图层缓存 ===
+    QPixmap createLayer() const;                             // 按设备像素比创建空白图层
+    void blitLayer(QPainter& painter, const QPixmap& layer, const QRegion& region);
+    void invalidateLayers();                                 // 丢弃图层，下次绘制时重建
+    void ensureBoardLayer();                                 // 背景 + 网格 + 障碍物
+    void ensureGameOverLayer();                              // 游戏结束界面的背景与纹理
+
+    // === 精灵图集 ===
+    void ensureSprites();                                    // 生成蛇身、蛇头、食物动画精灵
+    QRectF spriteRect(const QPoint& cell) const;             // 精灵的棋盘逻辑坐标绘制区域
+    QRectF spriteRect(const QPointF& cell) const;            // 同上，格子坐标可以是小数（插值位置）
+    int bodySprite(const QPoint& cell) const;                // 蛇身格子对应的精灵编号
+
+    // === 动画调度 ===
+    void updateAnimations();                                 // 按游戏状态开始 / 停止各个动画
+    void updateSuspension();                                 // 窗口不可见或未激活时挂起所有动画
+
+    // === OpenGL 棋盘后端 ===
+    void syncBoardBackend();                                 // 只在游戏进行中显示 OpenGL 棋盘
+    void fallBackToPainter();                                // OpenGL 不可用时改回 QPainter 绘制
+    QVector<QColor> boardPalette() const;                    // 按 InstancedBoardRenderer::CellKind 排列的颜色
+    QColor segmentBaseColor(int segmentSerial) const;        // 蛇身第 segmentSerial 号节的基础颜色
+
     // === 菜单渲染与交互 ===
     void renderMenu(QPainter& painter);
-    void renderPlaying(QPainter& painter);
+    void renderPlaying(QPainter& painter, const QRegion& region);
+    void renderBoard(QPainter& painter, const QRegion& region);  // 棋盘动态内容（QPainter 后端）
+    void renderScoreBar(QPainter& painter);
+    void renderPauseOverlay(QPainter& painter);                  // 暂停时压暗棋盘并显示提示
     void renderGameOver(QPainter& painter);
     void addMenuItem(QPainter& painter, const QString& text, int y, int key);
     void handleMenuKeyPress(int key);
     void handlePlayingKeyPress(int key);
     void handleGameOverKeyPress(int key);
+    void cycleAutopilot();                                       // 自动驾驶：关 -> A* -> 哈密顿回路 -> 关
+    QString autopilotLabel() const;                              // 当前自动驾驶模式的名称
 
     // === 成员变量 ===
     SnakeGame* game;                      // 游戏主逻辑控制器
-    QTimer* gameTimer;                    // 游戏刷新计时器
-    QTimer* foodAnimationTimer;          // 食物动画计时器
+    QTimer* gameTimer;                    // 显示帧计时器（按屏幕刷新率触发，逻辑帧由 SnakeGame 的固定步长时钟决定）
+    AnimationScheduler animations;        // 动画调度器（只在有动画播放时唤醒）
+    int foodPulse = -1;                   // 食物呼吸动画的编号
+    int menuPulse = -1;                   // 菜单预览食物呼吸动画的编号
 
     BodyColorScheme bodyColorScheme = ClassicBlue; // 当前选中的身体配色
     HeadShape selectedHeadShape = CircleHead;      // 当前蛇头形状
@@ -132,6 +207,34 @@ private:
     qreal foodScale = 1.0;       // 食物缩放（呼吸动画）
     qreal foodRotation = 0.0;    // 食物旋转角度
 
+    // 棋盘缩放：格子按 CELL_SIZE 的逻辑坐标绘制，再整体缩放到窗口中（大地图时每格不足 1 像素）
+    qreal boardScale = 1.0;
+    int boardPixelWidth = 0;     // 棋盘缩放后的像素宽度
+    int boardPixelHeight = 0;    // 棋盘缩放后的像素高度（其下方为分数栏）
+
+    // OpenGL 棋盘后端（为空时使用 QPainter 绘制棋盘）
+    GLBoardWidget* glBoard = nullptr;
+
+    // 静态图层：只在窗口尺寸、地图或设备像素比改变时重新生成
+    QPixmap boardLayer;
+    QPixmap gameOverLayer;
+
+    // 精灵图集：配色、蛇头形状或缩放改变时重新生成
+    SpriteAtlas sprites;
+    int spritePixelSize = 0;     // 当前图集中每个精灵的设备像素边长
+
+    // 局部重绘状态：蛇身各节的编号（按格子索引，颜色由编号决定，蛇移动时已有各节颜色不变）
+    QHash<int, quint32> segmentSerials;
+    quint32 nextSerial = 0;      // 最近一节蛇头的编号
+    quint64 lastTick = 0;        // 上次处理的逻辑帧号
+    QPoint lastHead;             // 上一帧的蛇头（本帧变为蛇身）
+    QPoint lastFood;             // 上一帧的食物位置
+    QPoint motionFrom;           // 蛇头在上一逻辑帧的位置（显示时从这里滑向当前蛇头）
+    QPoint tailFrom;             // 最近一个逻辑帧空出的蛇尾格子（显示时从这里滑向当前蛇尾）
+    bool tailMoving = false;     // 最近一个逻辑帧是否空出了蛇尾
+    bool showRepaintRegions = false; // 是否显示重绘区域调试叠加层（F3）
+    int repaintFlash = 0;        // 叠加层颜色轮换计数
+
     // 菜单项列表（用于渲染与点击响应）
     QList<MenuItem> menuItems;
 };
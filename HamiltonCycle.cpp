@@ -0,0 +1,64 @@
+#include "HamiltonCycle.h"
+
+HamiltonCycle::HamiltonCycle()
+    : width(0), height(0), length(0) {}
+
+bool HamiltonCycle::build(int w, int h, const OccupancyGrid& obstacles) {
+    width = w;
+    height = h;
+    length = 0;
+    successor.clear();
+    position.clear();
+    if (w < 2 || h < 2 || (w % 2 != 0 && h % 2 != 0)) return false;
+    for (int tile = 0; tile < obstacles.tileCount(); ++tile) {
+        if (obstacles.tilePopulation(tile) > 0) return false;
+    }
+    successor.assign(static_cast<size_t>(w) * h, 0);
+    position.assign(static_cast<size_t>(w) * h, 0);
+    buildSerpentine(h % 2 != 0);
+    return true;
+}
+
+void HamiltonCycle::buildSerpentine(bool transposed) {
+    // 在 rows x columns 的坐标系中构造：第 0 行从左到右，之后每行在第 1..columns-1 列之间往返，
+    // 最后一行（rows 为偶数，向左走）到达第 0 列，再沿第 0 列向上回到起点
+    const int rows = transposed ? width : height;
+    const int columns = transposed ? height : width;
+    auto cellOf = [&](int row, int column) { return transposed ? column * width + row : row * width + column; };
+
+    int previous = cellOf(0, 0);
+    auto append = [&](int cell) {
+        successor[previous] = cell;
+        position[cell] = length++;
+        previous = cell;
+    };
+    position[previous] = length++;
+    for (int column = 1; column < columns; ++column) {
+        append(cellOf(0, column));
+    }
+    for (int row = 1; row < rows; ++row) {
+        if (row % 2 == 1) {
+            for (int column = columns - 1; column >= 1; --column) append(cellOf(row, column));
+        } else {
+            for (int column = 1; column < columns; ++column) append(cellOf(row, column));
+        }
+    }
+    for (int row = rows - 1; row >= 1; --row) {
+        append(cellOf(row, 0));
+    }
+    successor[previous] = cellOf(0, 0);
+}
+
+void HamiltonCycle::reverse() {
+    if (!isValid()) return;
+    // 先按旧序号求出每个格子的前驱，再把前驱作为新的后继，序号随之翻转
+    std::vector<int> order(length);
+    for (size_t cell = 0; cell < position.size(); ++cell) {
+        order[position[cell]] = static_cast<int>(cell);
+    }
+    for (int i = 0; i < length; ++i) {
+        const int cell = order[i];
+        successor[cell] = order[(i + length - 1) % length];
+        position[cell] = (length - i) % length;
+    }
+}
\ No newline at end of file
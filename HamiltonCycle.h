@@ -0,0 +1,53 @@
+#ifndef HAMILTONCYCLE_H
+#define HAMILTONCYCLE_H
+
+#include <QtGlobal>
+#include <vector>
+#include "OccupancyGrid.h"
+
+// HamiltonCycle 类：经过地图上每个空闲格子恰好一次的回路，以查表形式保存
+//   successor[cell] 为回路上的下一个格子，position[cell] 为格子在回路上的序号，两者都是 O(1) 查询
+// 沿回路走的蛇永远不会撞到自己：身体在回路上依次排列，蛇头前方直到蛇尾的一段始终为空
+// 网格图是二分图，格子总数为奇数时不存在哈密顿回路；带任意障碍物的网格求回路是 NP 完全问题，
+// 因此这里只为没有障碍物、且至少一边为偶数的地图构造回路（蛇形扫描各行，再沿第 0 列返回）
+class HamiltonCycle {
+public:
+    // 构造函数：创建空回路（isValid() 为 false）
+    HamiltonCycle();
+
+    // 为 width x height、障碍物为 obstacles 的地图构造回路，无法构造时返回 false 并清空
+    bool build(int width, int height, const OccupancyGrid& obstacles);
+
+    // 是否已构造出回路
+    bool isValid() const { return length > 0; }
+
+    // 回路经过的格子数
+    int size() const { return length; }
+
+    // 回路上 cell 的下一个格子
+    int next(int cell) const { return successor[cell]; }
+
+    // cell 在回路上的序号（0..size()-1）
+    int indexOf(int cell) const { return position[cell]; }
+
+    // 沿回路从 from 走到 to 的步数（0..size()-1）
+    int distance(int from, int to) const {
+        const int d = position[to] - position[from];
+        return d < 0 ? d + length : d;
+    }
+
+    // 反转回路方向
+    void reverse();
+
+private:
+    // 沿蛇形扫描写入回路（transposed 为 true 时按列扫描，用于高为奇数、宽为偶数的地图）
+    void buildSerpentine(bool transposed);
+
+    int width;
+    int height;
+    int length;
+    std::vector<int> successor; // 回路上的下一个格子
+    std::vector<int> position;  // 格子在回路上的序号
+};
+
+#endif // HAMILTONCYCLE_H
\ No newline at end of file
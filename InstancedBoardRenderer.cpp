@@ -0,0 +1,191 @@
+#include "InstancedBoardRenderer.h"
+#include <QOpenGLContext>
+#include <QVector2D>
+#include <QVector4D>
+#include <algorithm>
+
+namespace {
+
+// 顶点着色器：每个实例是一个格子，4 个顶点由 gl_VertexID 生成（三角形带），不需要顶点缓冲区
+const char* const VERTEX_SHADER = R"(
+layout(location = 0) in uvec3 instance;
+uniform vec2 boardSize;
+uniform vec4 palette[PALETTE_SIZE];
+out vec2 local;
+flat out vec4 cellColor;
+flat out uint cellKind;
+void main() {
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    vec2 position = (vec2(instance.xy) + corner) / boardSize * 2.0 - 1.0;
+    gl_Position = vec4(position.x, -position.y, 0.0, 1.0);
+    local = corner;
+    cellColor = palette[instance.z];
+    cellKind = instance.z;
+}
+)";
+
+// 片元着色器：格子边缘压暗形成立体感，食物裁成圆形
+const char* const FRAGMENT_SHADER = R"(
+in vec2 local;
+flat in vec4 cellColor;
+flat in uint cellKind;
+out vec4 fragColor;
+void main() {
+    vec2 d = abs(local - 0.5);
+    if (cellKind == 1u && dot(d, d) > 0.16) discard;
+    float edge = 0.5 - max(d.x, d.y);
+    fragColor = vec4(cellColor.rgb * mix(0.7, 1.0, smoothstep(0.0, 0.15, edge)), cellColor.a);
+}
+)";
+
+const QColor BACKGROUND_COLOR(30, 30, 40);
+
+} // namespace
+
+InstancedBoardRenderer::InstancedBoardRenderer()
+    : program(nullptr), instanceBuffer(QOpenGLBuffer::VertexBuffer), bufferCapacity(0),
+      staticDirty(true), paletteDirty(true), initialized(false),
+      staticKey{0, -1, -1, -1}, boardWidth(1), boardHeight(1) {
+    palette.resize(PALETTE_SIZE);
+    palette[ObstacleCell] = QColor(100, 100, 100);
+    palette[FoodCell] = QColor(255, 80, 80);
+    palette[HeadCell] = QColor(0, 200, 0);
+    for (int i = 0; i < BODY_COLORS; ++i) {
+        palette[BodyCell + i] = QColor::fromHsv(i * 36, 200, 200);
+    }
+}
+
+bool InstancedBoardRenderer::initialize() {
+    initializeOpenGLFunctions();
+    if (!buildProgram()) return false;
+
+    vao.create();
+    vao.bind();
+    instanceBuffer.create();
+    instanceBuffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    instanceBuffer.bind();
+    // 实例属性：x、y、类型三个 16 位整数，每个实例前进一次
+    glEnableVertexAttribArray(0);
+    glVertexAttribIPointer(0, 3, GL_UNSIGNED_SHORT, sizeof(Instance), nullptr);
+    glVertexAttribDivisor(0, 1);
+    vao.release();
+    instanceBuffer.release();
+
+    bufferCapacity = 0;
+    staticDirty = true;
+    paletteDirty = true;
+    initialized = true;
+    return true;
+}
+
+void InstancedBoardRenderer::release() {
+    vao.destroy();
+    instanceBuffer.destroy();
+    delete program;
+    program = nullptr;
+    bufferCapacity = 0;
+    initialized = false;
+}
+
+bool InstancedBoardRenderer::buildProgram() {
+    // 桌面 OpenGL 使用 3.3 Core，OpenGL ES 使用 3.0，着色器主体相同
+    const bool es = QOpenGLContext::currentContext()->isOpenGLES();
+    QByteArray header = es ? QByteArray("#version 300 es\nprecision mediump float;\n")
+                           : QByteArray("#version 330 core\n");
+    header += "#define PALETTE_SIZE " + QByteArray::number(PALETTE_SIZE) + "\n";
+    delete program;
+    program = new QOpenGLShaderProgram();
+    if (!program->addShaderFromSourceCode(QOpenGLShader::Vertex, header + VERTEX_SHADER)
+        || !program->addShaderFromSourceCode(QOpenGLShader::Fragment, header + FRAGMENT_SHADER)
+        || !program->link()) {
+        delete program;
+        program = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void InstancedBoardRenderer::setPalette(const QVector<QColor>& colors) {
+    for (int i = 0; i < PALETTE_SIZE && i < colors.size(); ++i) {
+        palette[i] = colors[i];
+    }
+    paletteDirty = true;
+}
+
+void InstancedBoardRenderer::sync(const GameCore& core, const Snake& snake, const Food& food, quint64 tickCount) {
+    boardWidth = core.getWidth();
+    boardHeight = core.getHeight();
+
+    // 障碍物：只有换局后才重建并重新上传
+    const StaticKey key{core.getSeed(), boardWidth, boardHeight, static_cast<int>(core.getObstacles().size())};
+    if (!(key == staticKey)) {
+        staticKey = key;
+        obstacles.clear();
+        obstacles.reserve(core.getObstacles().size());
+        for (const QPoint& p : core.getObstacles()) {
+            append(obstacles, p.x(), p.y(), ObstacleCell);
+        }
+        staticDirty = true;
+    }
+
+    // 蛇身按编号着色：第 i 节是 i 帧之前的蛇头，编号取 tick - i，移动时已有各节颜色不变
+    const qint64 tick = static_cast<qint64>(tickCount);
+    cells.clear();
+    cells.reserve(snake.getLength() + 1);
+    for (int i = snake.getLength() - 1; i >= 1; --i) {
+        const Snake::CellIndex cell = snake.cellAt(i);
+        const int serial = static_cast<int>(((tick - i) % BODY_COLORS + BODY_COLORS) % BODY_COLORS);
+        append(cells, cell % boardWidth, cell / boardWidth, BodyCell + serial);
+    }
+    const QPoint head = snake.getHead();
+    if (snake.getOccupancy().contains(head)) {
+        append(cells, head.x(), head.y(), HeadCell);
+    }
+    const QPoint foodCell = food.getPosition();
+    if (snake.getOccupancy().contains(foodCell)) {
+        append(cells, foodCell.x(), foodCell.y(), FoodCell);
+    }
+}
+
+void InstancedBoardRenderer::render(int pixelWidth, int pixelHeight) {
+    glViewport(0, 0, pixelWidth, pixelHeight);
+    glClearColor(BACKGROUND_COLOR.redF(), BACKGROUND_COLOR.greenF(), BACKGROUND_COLOR.blueF(), 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    if (!initialized) return;
+
+    const int total = instanceCount();
+    if (total == 0) return;
+
+    // 上传实例：容量不足或换局时整体重新分配，否则只覆盖障碍物之后的动态部分
+    instanceBuffer.bind();
+    const int staticBytes = static_cast<int>(obstacles.size() * sizeof(Instance));
+    if (staticDirty || total > bufferCapacity) {
+        bufferCapacity = std::max(total, bufferCapacity * 2);
+        instanceBuffer.allocate(bufferCapacity * static_cast<int>(sizeof(Instance)));
+        if (!obstacles.empty()) instanceBuffer.write(0, obstacles.data(), staticBytes);
+        staticDirty = false;
+    }
+    if (!cells.empty()) {
+        instanceBuffer.write(staticBytes, cells.data(), static_cast<int>(cells.size() * sizeof(Instance)));
+    }
+    instanceBuffer.release();
+
+    program->bind();
+    program->setUniformValue("boardSize", QVector2D(boardWidth, boardHeight));
+    if (paletteDirty) {
+        QVector<QVector4D> colors(PALETTE_SIZE);
+        for (int i = 0; i < PALETTE_SIZE; ++i) {
+            colors[i] = QVector4D(palette[i].redF(), palette[i].greenF(), palette[i].blueF(), palette[i].alphaF());
+        }
+        program->setUniformValueArray("palette", colors.constData(), PALETTE_SIZE);
+        paletteDirty = false;
+    }
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // 整张棋盘一次绘制调用
+    vao.bind();
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, total);
+    vao.release();
+    program->release();
+}
\ No newline at end of file
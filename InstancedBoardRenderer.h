@@ -0,0 +1,102 @@
+#ifndef INSTANCEDBOARDRENDERER_H
+#define INSTANCEDBOARDRENDERER_H
+
+#include <QColor>
+#include <QOpenGLBuffer>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLVertexArrayObject>
+#include <QVector>
+#include <QtGlobal>
+#include <vector>
+#include "GameCore.h"
+
+// InstancedBoardRenderer 类：用 OpenGL 实例化绘制棋盘内容（障碍物、蛇身、蛇头、食物）
+// 每个被占用的格子是一个实例（格子坐标 + 类型），所有实例放在同一个实例缓冲区中，
+// 整张棋盘只需一次 glDrawArraysInstanced 调用，CPU 开销与格子数无关，只剩上传数据
+// 障碍物在开局后不再变化，放在缓冲区开头只上传一次；蛇身与食物每帧重新上传
+// 需要 OpenGL 3.3 Core 或 OpenGL ES 3.0（Mesa 的软件光栅化器 llvmpipe 也满足）
+// 不依赖窗口部件：既可由 GLBoardWidget 在屏幕上使用，也可在离屏上下文中使用（基准测试）
+class InstancedBoardRenderer : protected QOpenGLExtraFunctions {
+public:
+    // 实例类型（即调色板下标）：蛇身占用 BodyCell 起的 BODY_COLORS 个下标，按编号轮换颜色
+    enum CellKind { ObstacleCell = 0, FoodCell = 1, HeadCell = 2, BodyCell = 3 };
+    static constexpr int BODY_COLORS = 10;
+    static constexpr int PALETTE_SIZE = BodyCell + BODY_COLORS;
+
+    // 一个实例：格子坐标与类型（16 位足以表示 4096x4096 的地图）
+    struct Instance {
+        quint16 x;
+        quint16 y;
+        quint16 kind;
+        quint16 padding;
+    };
+
+    // 构造函数：只设置默认调色板，OpenGL 资源在 initialize() 中创建
+    InstancedBoardRenderer();
+
+    // 创建着色器、顶点数组与实例缓冲区（需要当前 OpenGL 上下文），失败时返回 false
+    bool initialize();
+
+    // 释放 OpenGL 资源（需要当前 OpenGL 上下文）
+    void release();
+
+    // OpenGL 资源是否可用
+    bool isInitialized() const { return initialized; }
+
+    // 设置调色板：colors 按 CellKind 顺序排列，共 PALETTE_SIZE 个颜色
+    void setPalette(const QVector<QColor>& colors);
+    QColor color(int kind) const { return palette.value(kind); }
+
+    // 从游戏核心收集实例：障碍物只在换局（种子或地图改变）时重建，蛇身与食物每次重建
+    void sync(const GameCore& core) { sync(core, core.getSnake(), core.getFood(), core.getTickCount()); }
+
+    // 同上，但蛇、食物与帧号单独给出（模拟线程发布的快照），地图尺寸、种子与障碍物取自 board
+    void sync(const GameCore& board, const Snake& snake, const Food& food, quint64 tickCount);
+
+    // 收集到的实例（障碍物 / 蛇身、蛇头与食物），按绘制顺序排列
+    const std::vector<Instance>& staticInstances() const { return obstacles; }
+    const std::vector<Instance>& dynamicInstances() const { return cells; }
+    int instanceCount() const { return static_cast<int>(obstacles.size() + cells.size()); }
+
+    // 把棋盘绘制到当前帧缓冲的 (0, 0) - (pixelWidth, pixelHeight) 区域
+    void render(int pixelWidth, int pixelHeight);
+
+private:
+    // 换局检测：同一种子、尺寸与障碍物数量对应同一张障碍物地图
+    struct StaticKey {
+        quint64 seed;
+        int width;
+        int height;
+        int obstacleCount;
+        bool operator==(const StaticKey& other) const {
+            return seed == other.seed && width == other.width && height == other.height
+                   && obstacleCount == other.obstacleCount;
+        }
+    };
+
+    // 按上下文类型（桌面 OpenGL / OpenGL ES）补上版本声明后编译着色器
+    bool buildProgram();
+
+    // 追加一个实例
+    static void append(std::vector<Instance>& list, int x, int y, int kind) {
+        list.push_back(Instance{static_cast<quint16>(x), static_cast<quint16>(y), static_cast<quint16>(kind), 0});
+    }
+
+    QOpenGLShaderProgram* program;  // 着色器程序（initialize 时创建）
+    QOpenGLVertexArrayObject vao;   // 记录实例属性格式的顶点数组对象
+    QOpenGLBuffer instanceBuffer;   // 实例缓冲区：[障碍物][蛇身 ... 蛇头][食物]
+    int bufferCapacity;             // 实例缓冲区当前容量（实例数）
+    bool staticDirty;               // 障碍物实例需要重新上传
+    bool paletteDirty;              // 调色板需要重新设置到着色器
+    bool initialized;
+
+    QVector<QColor> palette;        // 各类型的颜色
+    StaticKey staticKey;            // 当前障碍物实例对应的局面
+    int boardWidth;                 // 地图尺寸（格子数）
+    int boardHeight;
+    std::vector<Instance> obstacles; // 障碍物实例
+    std::vector<Instance> cells;     // 蛇身、蛇头与食物实例
+};
+
+#endif // INSTANCEDBOARDRENDERER_H
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram() {
+    clear();
+}
+
+void LatencyHistogram::clear() {
+    buckets.fill(0);
+    overflow = 0;
+    samples = 0;
+    total = 0;
+    maxNanos = 0;
+}
+
+void LatencyHistogram::add(qint64 nanos) {
+    nanos = std::max<qint64>(0, nanos);
+    const qint64 index = nanos / BUCKET_NANOS;
+    if (index < BUCKETS) {
+        ++buckets[index];
+    } else {
+        ++overflow;
+    }
+    ++samples;
+    total += nanos;
+    maxNanos = std::max(maxNanos, nanos);
+}
+
+qint64 LatencyHistogram::percentile(double p) const {
+    if (samples == 0) return 0;
+    // 排名为 ceil(p% * 样本数) 的样本所在的桶
+    const quint64 rank = std::max<quint64>(1, static_cast<quint64>(std::ceil(p / 100.0 * samples)));
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return std::min(maxNanos, (i + 1) * BUCKET_NANOS);
+    }
+    return maxNanos;
+}
\ No newline at end of file
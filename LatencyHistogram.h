@@ -0,0 +1,43 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QtGlobal>
+#include <array>
+
+// LatencyHistogram 类：固定桶宽的延迟直方图（每桶 BUCKET_NANOS，覆盖 0 ~ BUCKETS 毫秒）
+// 只做计数，不分配内存，可以整体复制进快照；百分位数按桶的上界给出，精度为一个桶宽
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS = 512;             // 桶数
+    static constexpr qint64 BUCKET_NANOS = 1000000; // 桶宽 1 ms
+
+    // 构造函数：创建空直方图
+    LatencyHistogram();
+
+    // 清空所有样本
+    void clear();
+
+    // 加入一个样本（纳秒，负数按 0 计，超出范围的计入溢出桶）
+    void add(qint64 nanos);
+
+    // 样本数 / 平均值 / 最大值（纳秒）
+    quint64 count() const { return samples; }
+    qint64 mean() const { return samples ? total / static_cast<qint64>(samples) : 0; }
+    qint64 max() const { return maxNanos; }
+
+    // 第 p 百分位（0 < p <= 100）所在桶的上界（纳秒）；落在溢出桶时返回最大值，没有样本时返回 0
+    qint64 percentile(double p) const;
+
+    // 第 i 个桶的样本数 / 超出范围的样本数
+    quint32 bucket(int i) const { return buckets[i]; }
+    quint32 overflowCount() const { return overflow; }
+
+private:
+    std::array<quint32, BUCKETS> buckets; // 各桶样本数
+    quint32 overflow;                     // 超出范围的样本数
+    quint64 samples;                      // 样本总数
+    qint64 total;                         // 样本总和（纳秒）
+    qint64 maxNanos;                      // 最大样本（纳秒）
+};
+
+#endif // LATENCYHISTOGRAM_H
\ No newline at end of file
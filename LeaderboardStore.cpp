@@ -0,0 +1,177 @@
+#include "LeaderboardStore.h"
+#include <QByteArray>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QList>
+#include <QSaveFile>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+const char* const FILE_MAGIC = "SNAKE-LEADERBOARD";
+const int FORMAT_VERSION = 2;
+const int FIELD_COUNT = 8;
+}
+
+LeaderboardStore::LeaderboardStore()
+    : dirty(false), stopRequested(false), loaded(false), writeCount(0), running(false) {}
+
+LeaderboardStore::~LeaderboardStore() {
+    close();
+}
+
+void LeaderboardStore::open(const QString& file) {
+    close();
+    path = file;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tables.clear();
+        dirty = false;
+        stopRequested = false;
+    }
+    loaded.store(false);
+    running = true;
+    worker = std::thread(&LeaderboardStore::run, this);
+}
+
+void LeaderboardStore::close() {
+    if (!running) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wake.notify_all();
+    worker.join();
+    running = false;
+}
+
+int LeaderboardStore::submit(const Key& key, const Entry& entry) {
+    int rank;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        rank = insert(tables, key, entry);
+        if (rank == 0) return 0;
+        dirty = true;
+    }
+    wake.notify_all();
+    return rank;
+}
+
+int LeaderboardStore::best(const Key& key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = tables.find(key);
+    return it == tables.end() || it->second.empty() ? 0 : it->second.front().score;
+}
+
+std::vector<LeaderboardStore::Entry> LeaderboardStore::entries(const Key& key) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = tables.find(key);
+    return it == tables.end() ? std::vector<Entry>() : it->second;
+}
+
+bool LeaderboardStore::ranksBefore(const Entry& a, const Entry& b) {
+    if (a.score != b.score) return a.score > b.score;
+    if (a.timeMillis != b.timeMillis) return a.timeMillis < b.timeMillis;
+    return a.date < b.date;
+}
+
+int LeaderboardStore::insert(Tables& tables, const Key& key, const Entry& entry) {
+    std::vector<Entry>& list = tables[key];
+    const auto position = std::upper_bound(list.begin(), list.end(), entry, &LeaderboardStore::ranksBefore);
+    const int rank = static_cast<int>(position - list.begin()) + 1;
+    if (rank > TOP_K) return 0;
+    list.insert(position, entry);
+    if (static_cast<int>(list.size()) > TOP_K) list.pop_back();
+    return rank;
+}
+
+void LeaderboardStore::run() {
+    // 加载期间界面线程可以照常提交，加载完成后与文件中的成绩合并；有新成绩时 dirty 保持为 true，随后写回
+    const Tables stored = readFile(path);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& table : stored) {
+            for (const Entry& entry : table.second) {
+                insert(tables, table.first, entry);
+            }
+        }
+    }
+    loaded.store(true);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this]() { return dirty || stopRequested; });
+        if (!stopRequested) {
+            // 攒批：等待一段时间，让连续的提交合并为一次写入（停止请求会立即结束等待）
+            wake.wait_for(lock, std::chrono::milliseconds(FLUSH_DELAY_MS), [this]() { return stopRequested; });
+        }
+        if (dirty) {
+            const Tables snapshot = tables;
+            dirty = false;
+            lock.unlock();
+            if (writeFile(path, snapshot)) {
+                ++writeCount;
+            } else {
+                qDebug() << "Failed to save leaderboard:" << path;
+            }
+            lock.lock();
+        }
+        if (stopRequested) return;
+    }
+}
+
+LeaderboardStore::Tables LeaderboardStore::readFile(const QString& path) {
+    Tables result;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return result; // 首次运行时文件还不存在
+    }
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    const QList<QByteArray> header = lines.first().simplified().split(' ');
+    bool versionOk = false;
+    const int version = header.size() == 2 ? header[1].toInt(&versionOk) : 0;
+    if (header.size() != 2 || header[0] != FILE_MAGIC || !versionOk || version < 1 || version > FORMAT_VERSION) {
+        qDebug() << "Invalid leaderboard file:" << path;
+        return result;
+    }
+    const qint64 timeUnit = version == 1 ? 1000 : 1; // 版本 1 的用时以秒为单位
+    for (int i = 1; i < lines.size(); ++i) {
+        const QList<QByteArray> fields = lines[i].simplified().split(' ');
+        if (fields.size() != FIELD_COUNT) continue; // 空行或损坏的行
+        bool ok[FIELD_COUNT];
+        const Key key{fields[0].toInt(&ok[0]), fields[1].toInt(&ok[1]), fields[2].toInt(&ok[2]), fields[3].toInt(&ok[3])};
+        Entry entry;
+        entry.score = fields[4].toInt(&ok[4]);
+        entry.timeMillis = fields[5].toLongLong(&ok[5]) * timeUnit;
+        entry.seed = fields[6].toULongLong(&ok[6]);
+        entry.date = fields[7].toLongLong(&ok[7]);
+        if (std::all_of(ok, ok + FIELD_COUNT, [](bool v) { return v; })) {
+            insert(result, key, entry);
+        }
+    }
+    return result;
+}
+
+bool LeaderboardStore::writeFile(const QString& path, const Tables& tables) {
+    QByteArray data(FILE_MAGIC);
+    data += ' ' + QByteArray::number(FORMAT_VERSION) + '\n';
+    for (const auto& table : tables) {
+        const Key& key = table.first;
+        for (const Entry& entry : table.second) {
+            data += QByteArray::number(key.map) + ' ' + QByteArray::number(key.width) + ' '
+                    + QByteArray::number(key.height) + ' ' + QByteArray::number(key.difficulty) + ' '
+                    + QByteArray::number(entry.score) + ' ' + QByteArray::number(entry.timeMillis) + ' '
+                    + QByteArray::number(entry.seed) + ' ' + QByteArray::number(entry.date) + '\n';
+        }
+    }
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    // QSaveFile 写入同目录下的临时文件，commit() 时才原子地替换目标文件
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(data);
+    return file.commit();
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef LEADERBOARDSTORE_H
+#define LEADERBOARDSTORE_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// LeaderboardStore 类：按地图与难度分别保存前 TOP_K 名成绩的排行榜，磁盘读写全部在后台线程完成
+//   读取：open() 只启动后台线程，由它加载文件；加载完成前查询到的是本次运行中提交的成绩
+//   写入：submit() 只在内存中插入并唤醒后台线程，后台线程再等 FLUSH_DELAY_MS 把期间的提交合并为一次写入
+//   持久化：先写临时文件再原子重命名（QSaveFile），写到一半崩溃时旧文件保持完整
+// 界面线程与后台线程共享的排行榜由互斥锁保护，锁内只做内存操作，不做磁盘读写
+// 文件格式：首行 "SNAKE-LEADERBOARD 2"，之后每行一条成绩：
+//   地图类型 宽 高 难度 得分 用时(毫秒) 种子 日期(UTC 毫秒时间戳)
+// 版本 1 的用时以秒为单位，读取时换算为毫秒
+class LeaderboardStore {
+public:
+    static constexpr int TOP_K = 10;           // 每个排行榜保留的成绩数
+    static constexpr int FLUSH_DELAY_MS = 500; // 收到提交后等待合并的时间
+
+    // 排行榜的键：地图类型、地图尺寸与难度相同的对局放在同一个榜上
+    struct Key {
+        int map;
+        int width;
+        int height;
+        int difficulty;
+        bool operator<(const Key& other) const {
+            if (map != other.map) return map < other.map;
+            if (width != other.width) return width < other.width;
+            if (height != other.height) return height < other.height;
+            return difficulty < other.difficulty;
+        }
+    };
+
+    // 一条成绩
+    struct Entry {
+        int score = 0;         // 得分
+        qint64 timeMillis = 0; // 用时（毫秒，游戏时钟读数）
+        quint64 seed = 0;      // 对局种子（以相同的 --board、--obstacles 加 --seed 启动可复现地图与食物序列）
+        qint64 date = 0;       // 结束时刻（UTC 毫秒时间戳）
+    };
+
+    // 构造函数：创建未打开的排行榜（不访问磁盘）
+    LeaderboardStore();
+
+    // 析构函数：写出尚未保存的成绩并等待后台线程退出
+    ~LeaderboardStore();
+
+    // 打开排行榜文件：启动后台线程并在其中加载，立即返回；已打开时先关闭
+    void open(const QString& path);
+
+    // 写出尚未保存的成绩并停止后台线程（未打开时无操作）
+    void close();
+
+    // 文件是否已加载完成（不存在或无法读取也算完成）
+    bool isLoaded() const { return loaded.load(); }
+
+    // 提交一条成绩（只修改内存，不等待磁盘），返回它在当前已知成绩中的名次（从 1 开始），未进入前 TOP_K 时返回 0
+    int submit(const Key& key, const Entry& entry);
+
+    // 某个排行榜的最高分（没有成绩时为 0）
+    int best(const Key& key) const;
+
+    // 某个排行榜的成绩（按名次排列）
+    std::vector<Entry> entries(const Key& key) const;
+
+    // 后台线程已完成的写入次数（多次提交合并为一次写入时只计一次）
+    quint64 getWriteCount() const { return writeCount.load(); }
+
+    // 排名规则：得分高者在前，同分用时短者在前，再相同时先达成者在前
+    static bool ranksBefore(const Entry& a, const Entry& b);
+
+private:
+    typedef std::map<Key, std::vector<Entry>> Tables;
+
+    // 后台线程主循环：加载文件，之后等待提交并合并写入
+    void run();
+
+    // 把一条成绩插入排行榜并截断到 TOP_K（调用方持有锁），返回名次或 0
+    static int insert(Tables& tables, const Key& key, const Entry& entry);
+
+    // 读取 / 写入排行榜文件（在后台线程中调用，不持有锁）
+    static Tables readFile(const QString& path);
+    static bool writeFile(const QString& path, const Tables& tables);
+
+    QString path;                      // 排行榜文件路径
+    Tables tables;                     // 所有排行榜（受 mutex 保护）
+    bool dirty;                        // 有尚未写入文件的成绩（受 mutex 保护）
+    bool stopRequested;                // 请求后台线程退出（受 mutex 保护）
+    mutable std::mutex mutex;
+    std::condition_variable wake;      // 提交或停止时唤醒后台线程
+    std::atomic<bool> loaded;
+    std::atomic<quint64> writeCount;
+    std::thread worker;
+    bool running;
+};
+
+#endif // LEADERBOARDSTORE_H
\ No newline at end of file
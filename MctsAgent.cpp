@@ -0,0 +1,251 @@
+#include "MctsAgent.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+const Snake::Direction DIRECTIONS[4] = {Snake::Up, Snake::Down, Snake::Left, Snake::Right};
+const int GREEDY_ROLLOUT_PERCENT = 75; // 推演时选离食物最近的安全方向的概率
+
+qint64 nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 两个格子编号的曼哈顿距离
+int manhattan(int a, int b, int width) {
+    return std::abs(a % width - b % width) + std::abs(a / width - b / width);
+}
+
+} // namespace
+
+MctsAgent::MctsAgent(WorkStealingPool* pool)
+    : pool(pool), workers(pool ? pool->size() : 1), root(nullptr), rolloutDepth(0), deadline(0),
+      started(0), playoutLimit(0) {
+    seed(1);
+}
+
+void MctsAgent::seed(quint64 seed) {
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].rng.seed(seed ^ (static_cast<quint64>(i) * 0x9E3779B97F4A7C15ULL));
+    }
+}
+
+Snake::Direction MctsAgent::choose(const GameCore& core) {
+    const Snake::Direction current = core.getSnake().getDirection();
+    if (core.isGameOver() || !canSearch(core.getWidth(), core.getHeight())) return current;
+    ++stats.decisions;
+
+    obstacles.load(core);
+    rootState.load(core, &obstacles);
+    if (table.capacity() < (quint64(1) << TABLE_BITS)) {
+        table.resize(TABLE_BITS);
+    } else {
+        table.clear();
+    }
+    for (Worker& worker : workers) {
+        worker.arena.reset();
+        worker.playouts = 0;
+        worker.nodes = 0;
+        worker.transpositions = 0;
+    }
+    rolloutDepth = config.rolloutDepth > 0 ? config.rolloutDepth : 2 * (core.getWidth() + core.getHeight());
+
+    // 根节点先在调用线程上展开：只有一个方向安全（或全都不安全）时不必搜索
+    root = workers[0].arena.create<Node>(current);
+    ++workers[0].nodes;
+    table.insert(rootState.getHash(), reinterpret_cast<quintptr>(root));
+    expand(workers[0], root, rootState, true);
+    if (root->childCount == 1 || !rootState.isSafe(root->children[0]->move)) {
+        ++stats.forcedMoves;
+        stats.nodes += workers[0].nodes;
+        return root->children[0]->move;
+    }
+
+    const qint64 begin = nowNanos();
+    deadline = config.budgetNanos > 0 ? begin + config.budgetNanos : 0;
+    playoutLimit = config.maxPlayouts > 0 || config.budgetNanos > 0 ? config.maxPlayouts : 1;
+    started.store(0, std::memory_order_relaxed);
+    if (pool && pool->size() > 1) {
+        // 每个线程一个任务，各自搜索到截止时刻；任务被偷走时由偷取的线程接着做，结果相同
+        pool->parallelFor(static_cast<quint64>(pool->size()), 1, [this](int worker, quint64 first, quint64 last) {
+            for (quint64 task = first; task < last; ++task) {
+                search(worker);
+            }
+        });
+    } else {
+        search(0);
+    }
+    stats.searchNanos += nowNanos() - begin;
+
+    size_t arenaBytes = 0;
+    for (const Worker& worker : workers) {
+        stats.playouts += worker.playouts;
+        stats.nodes += worker.nodes;
+        stats.transpositions += worker.transpositions;
+        arenaBytes += worker.arena.bytesUsed();
+    }
+    stats.peakArenaBytes = std::max(stats.peakArenaBytes, arenaBytes);
+
+    // 选访问次数最多的方向（次数相同取平均回报高的）
+    Node* best = root->children[0];
+    for (int i = 1; i < root->childCount; ++i) {
+        Node* child = root->children[i];
+        const qint64 visits = child->visits.load(std::memory_order_relaxed);
+        const qint64 bestVisits = best->visits.load(std::memory_order_relaxed);
+        if (visits > bestVisits
+            || (visits == bestVisits && child->value.load(std::memory_order_relaxed) > best->value.load(std::memory_order_relaxed))) {
+            best = child;
+        }
+    }
+    return best->move;
+}
+
+void MctsAgent::search(int index) {
+    Worker& worker = workers[index];
+    for (;;) {
+        if (playoutLimit > 0 && started.fetch_add(1, std::memory_order_relaxed) >= playoutLimit) return;
+        if (deadline > 0 && nowNanos() >= deadline) return;
+        playout(worker);
+    }
+}
+
+void MctsAgent::playout(Worker& worker) {
+    RolloutState& state = worker.state;
+    state.copyFrom(rootState);
+    worker.path.clear();
+    worker.path.push_back(root);
+    root->virtualVisits.fetch_add(config.virtualLoss, std::memory_order_relaxed);
+
+    // 选择：沿已展开的节点下行，同时推进局面
+    Node* node = root;
+    int steps = 0;
+    bool exact = true;
+    double foods = 0.0; // 吃到的食物，越早吃到计得越多
+    RolloutState::Result result = RolloutState::Moved;
+    for (;;) {
+        if (node->expansion.load(std::memory_order_acquire) != 2) {
+            // 展开：新节点的子节点中随机取一个作为本次模拟的下一步
+            if (!expand(worker, node, state, exact)) break;
+            node = node->children[worker.rng.bounded(node->childCount)];
+        } else {
+            node = select(node);
+        }
+        node->virtualVisits.fetch_add(config.virtualLoss, std::memory_order_relaxed);
+        worker.path.push_back(node);
+        result = state.step(node->move, worker.rng);
+        ++steps;
+        if (result == RolloutState::AteFood) {
+            foods += 1.0 - double(steps) / rolloutDepth;
+            exact = false;
+        }
+        // 图中可能有环（蛇绕一圈回到同一局面），下行步数也受推演步数限制
+        if (result == RolloutState::Died || result == RolloutState::Filled || steps >= rolloutDepth
+            || node->visits.load(std::memory_order_relaxed) == 0) {
+            break;
+        }
+    }
+
+    // 推演
+    state.stopHashing();
+    while (result != RolloutState::Died && result != RolloutState::Filled && steps < rolloutDepth) {
+        result = state.step(rolloutMove(state, worker.rng), worker.rng);
+        ++steps;
+        if (result == RolloutState::AteFood) foods += 1.0 - double(steps) / rolloutDepth;
+    }
+    const double survival = result == RolloutState::Died ? double(steps - 1) / rolloutDepth : 1.0;
+    const double food = result == RolloutState::Filled ? 1.0 : std::min(1.0, foods / FOOD_TARGET);
+    const qint64 reward = static_cast<qint64>((0.5 * survival + 0.5 * food) * REWARD_SCALE);
+
+    // 回溯：计入真实访问与回报，撤销虚拟损失
+    for (Node* visited : worker.path) {
+        visited->value.fetch_add(reward, std::memory_order_relaxed);
+        visited->visits.fetch_add(1, std::memory_order_relaxed);
+        visited->virtualVisits.fetch_sub(config.virtualLoss, std::memory_order_relaxed);
+    }
+    ++worker.playouts;
+}
+
+bool MctsAgent::expand(Worker& worker, Node* node, const RolloutState& state, bool exact) {
+    int expected = 0;
+    if (!node->expansion.compare_exchange_strong(expected, 1, std::memory_order_acquire)) return false;
+    for (Snake::Direction dir : DIRECTIONS) {
+        if (state.isSafe(dir)) {
+            node->children[node->childCount++] = child(worker, dir, state, exact);
+        }
+    }
+    if (node->childCount == 0) {
+        for (Snake::Direction dir : DIRECTIONS) {
+            if (!Snake::isOpposite(dir, state.getDirection())) {
+                node->children[node->childCount++] = child(worker, dir, state, false);
+            }
+        }
+    }
+    node->expansion.store(2, std::memory_order_release);
+    return true;
+}
+
+MctsAgent::Node* MctsAgent::child(Worker& worker, Snake::Direction dir, const RolloutState& state, bool exact) {
+    if (!exact || state.neighbor(dir) == state.getFood()) {
+        ++worker.nodes;
+        return worker.arena.create<Node>(dir);
+    }
+    // 子局面的散列相同即为同一局面（方向也计入散列，因此链接到的节点的 move 一定是 dir）
+    const quint64 key = state.hashAfter(dir);
+    if (const quint64 existing = table.find(key)) {
+        ++worker.transpositions;
+        return reinterpret_cast<Node*>(existing);
+    }
+    Node* fresh = worker.arena.create<Node>(dir);
+    ++worker.nodes;
+    const quint64 stored = table.insert(key, reinterpret_cast<quintptr>(fresh));
+    if (stored != 0 && stored != reinterpret_cast<quintptr>(fresh)) {
+        // 另一个线程抢先插入了同一局面：改用它的节点（fresh 留在 arena 中，决策结束时一并回收）
+        ++worker.transpositions;
+        return reinterpret_cast<Node*>(stored);
+    }
+    return fresh;
+}
+
+MctsAgent::Node* MctsAgent::select(Node* node) const {
+    const int parentVisits = node->visits.load(std::memory_order_relaxed) + node->virtualVisits.load(std::memory_order_relaxed);
+    const double logParent = std::log(std::max(1, parentVisits));
+    Node* best = node->children[0];
+    double bestScore = -1.0;
+    for (int i = 0; i < node->childCount; ++i) {
+        Node* child = node->children[i];
+        // 虚拟损失记作回报为 0 的访问：降低平均回报，让其他线程暂时选别的分支
+        const int visits = child->visits.load(std::memory_order_relaxed) + child->virtualVisits.load(std::memory_order_relaxed);
+        if (visits == 0) return child;
+        const double mean = double(child->value.load(std::memory_order_relaxed)) / REWARD_SCALE / visits;
+        const double score = mean + config.exploration * std::sqrt(logParent / visits);
+        if (score > bestScore) {
+            bestScore = score;
+            best = child;
+        }
+    }
+    return best;
+}
+
+Snake::Direction MctsAgent::rolloutMove(const RolloutState& state, Random& rng) {
+    Snake::Direction safe[3];
+    int count = 0;
+    for (Snake::Direction dir : DIRECTIONS) {
+        if (state.isSafe(dir)) safe[count++] = dir;
+    }
+    if (count == 0) return state.getDirection();
+    if (state.getFood() >= 0 && rng.bounded(100) < GREEDY_ROLLOUT_PERCENT) {
+        Snake::Direction best = safe[0];
+        int bestDistance = manhattan(state.neighbor(best), state.getFood(), state.getWidth());
+        for (int i = 1; i < count; ++i) {
+            const int distance = manhattan(state.neighbor(safe[i]), state.getFood(), state.getWidth());
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = safe[i];
+            }
+        }
+        return best;
+    }
+    return safe[rng.bounded(count)];
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#ifndef MCTSAGENT_H
+#define MCTSAGENT_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <vector>
+#include "BumpArena.h"
+#include "GameCore.h"
+#include "Random.h"
+#include "RolloutState.h"
+#include "TranspositionTable.h"
+#include "WorkStealingPool.h"
+
+// MctsAgent 类：蒙特卡洛树搜索（UCT）智能体，每个逻辑帧在时间预算内搜索后选择一个方向
+// 树是开环的：节点只记录从根出发的方向序列，不保存局面；每次模拟把根局面克隆到线程自己的
+// RolloutState，沿选中的路径推进，再用“偏向食物的随机安全走法”推演到 rolloutDepth 步，
+// 按存活步数与吃到的食物数给出 [0, 1] 的回报。树节点从线程自己的 BumpArena 分配，
+// 每次决策开始时整体回收，不逐个释放
+// 多线程时所有线程在同一棵树上搜索：下行时给经过的节点加虚拟损失（记作一次回报为 0 的访问），
+// 让其他线程暂时避开同一条路径；回溯时再撤销。访问数、回报和与展开状态都是原子量，不加锁
+// 吃到食物之前局面由方向序列唯一决定，不同的走法顺序可能到达同一局面（例如先上后右与先右后上，
+// 蛇身较短时尾部也随之重合）：展开时以子局面的 Zobrist 散列查无锁置换表，已有节点直接链接过去，
+// 多条路径共享同一个节点的统计，不再重复展开（树变为有向图）
+class MctsAgent {
+public:
+    static constexpr int MAX_CELLS = 512 * 512;             // 允许搜索的最大格子数
+    static constexpr qint64 DEFAULT_BUDGET_NANOS = 5000000; // 默认每步 5 ms
+    static constexpr int TABLE_BITS = 16;                   // 置换表 2^16 个槽位（第一次搜索时分配）
+    static constexpr int FOOD_TARGET = 2;                   // 食物回报满额所需的食物数（第 k 步吃到计 1 - k / 推演步数）
+
+    // 搜索参数
+    struct Config {
+        qint64 budgetNanos = DEFAULT_BUDGET_NANOS; // 每步的时间预算（0 表示不限时）
+        quint64 maxPlayouts = 0;    // 每步最多模拟次数（0 表示不限；两者都为 0 时按 1 次计）
+        double exploration = 0.7;   // UCT 探索系数
+        int virtualLoss = 1;        // 每个正在进行的模拟给路径上节点加的虚拟访问数
+        int rolloutDepth = 0;       // 从根算起的推演步数（0 表示 2 * (宽 + 高)）
+    };
+
+    // 搜索统计（从构造或 resetStats() 起累计）
+    struct Stats {
+        quint64 decisions = 0;      // 决策次数
+        quint64 forcedMoves = 0;    // 只有一个安全方向（或没有）而跳过搜索的次数
+        quint64 playouts = 0;       // 模拟次数
+        quint64 nodes = 0;          // 分配的树节点数
+        quint64 transpositions = 0; // 展开时经置换表链接到已有节点的子节点数
+        qint64 searchNanos = 0;     // 搜索耗时之和
+        size_t peakArenaBytes = 0;  // 单次决策所有线程 arena 用量之和的最大值
+
+        // 每秒模拟次数（所有线程合计）
+        double playoutsPerSecond() const { return searchNanos > 0 ? playouts * 1e9 / searchNanos : 0.0; }
+    };
+
+    // 地图是否小到可以搜索
+    static bool canSearch(int width, int height) { return width * height <= MAX_CELLS; }
+
+    // 构造函数：pool 不为空时在其所有线程上并行搜索（pool 须比本对象存活更久），否则只用调用线程
+    explicit MctsAgent(WorkStealingPool* pool = nullptr);
+
+    // 设置 / 获取搜索参数
+    void setConfig(const Config& config) { this->config = config; }
+    const Config& getConfig() const { return config; }
+
+    // 重新设置推演用的随机数种子（单线程且只按 maxPlayouts 限制时，相同种子得到相同决策）
+    void seed(quint64 seed);
+
+    // 为 core 的当前局面选择方向（游戏已结束或地图过大时返回当前方向）
+    Snake::Direction choose(const GameCore& core);
+
+    // 搜索线程数
+    int threads() const { return static_cast<int>(workers.size()); }
+
+    // 搜索统计
+    const Stats& getStats() const { return stats; }
+    void resetStats() { stats = Stats(); }
+
+private:
+    static constexpr qint64 REWARD_SCALE = 1 << 20; // 回报和按定点数累加
+
+    // 树节点（开环：只记录到达它的方向）
+    struct Node {
+        Node* children[3];                 // 展开后的子节点（不含掉头方向）
+        int childCount;
+        Snake::Direction move;             // 从父节点到本节点的方向
+        std::atomic<int> expansion;        // 0 未展开，1 展开中，2 已展开（children 可读）
+        std::atomic<int> visits;
+        std::atomic<int> virtualVisits;    // 正在经过本节点的模拟的虚拟损失
+        std::atomic<qint64> value;         // 回报和（定点数）
+
+        explicit Node(Snake::Direction move)
+            : childCount(0), move(move), expansion(0), visits(0), virtualVisits(0), value(0) {}
+    };
+
+    // 每个线程的搜索上下文，独占缓存行
+    struct alignas(64) Worker {
+        BumpArena arena;             // 本线程分配的树节点
+        RolloutState state;          // 模拟用的局面
+        Random rng;
+        std::vector<Node*> path;     // 本次模拟经过的节点
+        quint64 playouts = 0;
+        quint64 nodes = 0;
+        quint64 transpositions = 0;
+    };
+
+    // 线程 worker 的搜索循环
+    void search(int worker);
+
+    // 一次模拟：选择、展开、推演、回溯
+    void playout(Worker& worker);
+
+    // 在当前局面上展开 node（只加入不会立即撞死的方向，全部会撞死时加入全部三个），
+    // 其他线程正在展开时返回 false；exact 表示本次模拟还没有吃到食物（局面与路径一一对应，可查置换表）
+    bool expand(Worker& worker, Node* node, const RolloutState& state, bool exact);
+
+    // 展开时为方向 dir 取得子节点：exact 且这一步不吃食物时先查置换表，否则新建
+    Node* child(Worker& worker, Snake::Direction dir, const RolloutState& state, bool exact);
+
+    // 按带虚拟损失的 UCT 选择子节点
+    Node* select(Node* node) const;
+
+    // 推演的走法：大概率选离食物最近的安全方向，否则随机选安全方向
+    static Snake::Direction rolloutMove(const RolloutState& state, Random& rng);
+
+    WorkStealingPool* pool;
+    Config config;
+    Stats stats;
+    RolloutState::Obstacles obstacles; // 本次决策所有局面共享的障碍物位图
+    RolloutState rootState;
+    TranspositionTable table;          // 子局面散列 -> 节点，每次决策开始时清空
+    std::vector<Worker> workers;
+    Node* root;
+    int rolloutDepth;
+    qint64 deadline;                   // 本次决策的截止时刻（steady_clock 纳秒，0 表示不限时）
+    std::atomic<quint64> started;      // 本次决策已开始的模拟数（用于 maxPlayouts）
+    quint64 playoutLimit;
+};
+
+#endif // MCTSAGENT_H
\ No newline at end of file
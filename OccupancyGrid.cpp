@@ -0,0 +1,112 @@
+#include "OccupancyGrid.h"
+#include <algorithm>
+
+OccupancyGrid::OccupancyGrid(int width, int height)
+    : gridWidth(0), gridHeight(0), tileColumns(0), tileRows(0) {
+    resize(width, height);
+}
+
+OccupancyGrid::OccupancyGrid(const OccupancyGrid& other)
+    : gridWidth(other.gridWidth), gridHeight(other.gridHeight), tileColumns(other.tileColumns),
+      tileRows(other.tileRows), tiles(other.tiles), populations(other.populations) {
+}
+
+OccupancyGrid& OccupancyGrid::operator=(const OccupancyGrid& other) {
+    if (this == &other) return *this;
+    gridWidth = other.gridWidth;
+    gridHeight = other.gridHeight;
+    tileColumns = other.tileColumns;
+    tileRows = other.tileRows;
+    tiles.resize(other.tiles.size());
+    populations.resize(other.populations.size());
+    for (int t = 0; t < static_cast<int>(tiles.size()); ++t) {
+        const std::vector<quint64>& source = other.tiles[t];
+        std::vector<quint64>& tile = tiles[t];
+        if (source.empty()) {
+            if (!tile.empty()) {
+                std::fill(tile.begin(), tile.end(), 0);
+                releaseTile(t);
+            }
+            continue;
+        }
+        if (tile.empty() && !spare.empty()) {
+            tile = std::move(spare.back());
+            spare.pop_back();
+        }
+        tile = source;
+    }
+    populations = other.populations;
+    return *this;
+}
+
+void OccupancyGrid::resize(int width, int height) {
+    gridWidth = std::max(0, width);
+    gridHeight = std::max(0, height);
+    tileColumns = (gridWidth + TILE_SIZE - 1) >> TILE_SHIFT;
+    tileRows = (gridHeight + TILE_SIZE - 1) >> TILE_SHIFT;
+    tiles.assign(tileColumns * tileRows, std::vector<quint64>());
+    populations.assign(tileColumns * tileRows, 0);
+    spare.clear();
+}
+
+void OccupancyGrid::clear() {
+    for (int t = 0; t < static_cast<int>(tiles.size()); ++t) {
+        if (tiles[t].empty()) continue;
+        std::fill(tiles[t].begin(), tiles[t].end(), 0);
+        releaseTile(t);
+    }
+}
+
+void OccupancyGrid::releaseTile(int t) {
+    // 保留少量空块以免蛇在分块边界来回移动时反复分配；超出部分直接释放
+    if (spare.size() < MAX_SPARE_TILES) {
+        spare.push_back(std::move(tiles[t]));
+    }
+    std::vector<quint64>().swap(tiles[t]);
+    populations[t] = 0;
+}
+
+void OccupancyGrid::set(const QPoint& p) {
+    if (!contains(p)) return;
+    const int t = tileOf(p);
+    std::vector<quint64>& tile = tiles[t];
+    if (tile.empty()) {
+        // 按需分配分块，优先复用回收的空块
+        if (!spare.empty()) {
+            tile = std::move(spare.back());
+            spare.pop_back();
+        } else {
+            tile.assign(TILE_SIZE, 0);
+        }
+    }
+    quint64& row = tile[p.y() & (TILE_SIZE - 1)];
+    const quint64 bit = quint64(1) << (p.x() & (TILE_SIZE - 1));
+    if (!(row & bit)) {
+        row |= bit;
+        ++populations[t];
+    }
+}
+
+void OccupancyGrid::reset(const QPoint& p) {
+    if (!contains(p)) return;
+    const int t = tileOf(p);
+    std::vector<quint64>& tile = tiles[t];
+    if (tile.empty()) return;
+    quint64& row = tile[p.y() & (TILE_SIZE - 1)];
+    const quint64 bit = quint64(1) << (p.x() & (TILE_SIZE - 1));
+    if (row & bit) {
+        row &= ~bit;
+        // 整块清空后回收（此时所有行都为 0，可直接复用）
+        if (--populations[t] == 0) {
+            releaseTile(t);
+        }
+    }
+}
+
+int OccupancyGrid::allocatedTiles() const {
+    int count = 0;
+    for (const std::vector<quint64>& tile : tiles) {
+        if (!tile.empty()) ++count;
+    }
+    return count;
+}
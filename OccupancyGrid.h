@@ -0,0 +1,85 @@
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include <QPoint>
+#include <QtGlobal>
+#include <vector>
+
+// OccupancyGrid 类：按格子存储的占用位图（每格 1 bit），用于 O(1) 判断某个格子是否被占用
+// 位图按 64x64 的分块（tile）懒分配：每块 64 个 64 位字，每个字对应块内的一行
+// 从未被占用过的块不分配内存，清空的块回收复用，因此超大地图的内存只与占用区域成正比
+class OccupancyGrid {
+public:
+    static constexpr int TILE_SHIFT = 6;                // 分块边长的对数
+    static constexpr int TILE_SIZE = 1 << TILE_SHIFT;   // 分块边长（格子数）
+
+    // 构造函数：创建指定宽高的空位图
+    OccupancyGrid(int width = 0, int height = 0);
+
+    // 复制只复制尺寸、已分配的分块与计数，不复制回收的空块（它们只是分配缓存）；
+    // 赋值时尽量复用本对象已有的分块，多出的分块清零后回收，逐帧复制到同一个对象时不分配内存
+    OccupancyGrid(const OccupancyGrid& other);
+    OccupancyGrid& operator=(const OccupancyGrid& other);
+    OccupancyGrid(OccupancyGrid&& other) = default;
+    OccupancyGrid& operator=(OccupancyGrid&& other) = default;
+
+    // 重新设置尺寸（同时清空所有格子）
+    void resize(int width, int height);
+
+    // 清空所有格子
+    void clear();
+
+    // 获取宽度 / 高度
+    int width() const { return gridWidth; }
+    int height() const { return gridHeight; }
+
+    // 判断坐标是否在地图范围内
+    bool contains(const QPoint& p) const {
+        return p.x() >= 0 && p.x() < gridWidth && p.y() >= 0 && p.y() < gridHeight;
+    }
+
+    // 判断格子是否被占用（越界的格子视为未占用）
+    bool test(const QPoint& p) const {
+        if (!contains(p)) return false;
+        const std::vector<quint64>& tile = tiles[tileOf(p)];
+        if (tile.empty()) return false;
+        return (tile[p.y() & (TILE_SIZE - 1)] >> (p.x() & (TILE_SIZE - 1))) & 1u;
+    }
+
+    // 标记格子为占用（越界时忽略）
+    void set(const QPoint& p);
+
+    // 取消格子的占用标记（越界时忽略）
+    void reset(const QPoint& p);
+
+    // === 分块访问（供空闲格子索引、渲染等按块遍历） ===
+    int tilesX() const { return tileColumns; }
+    int tilesY() const { return tileRows; }
+    int tileCount() const { return tileColumns * tileRows; }
+    int tileOf(const QPoint& p) const { return (p.y() >> TILE_SHIFT) * tileColumns + (p.x() >> TILE_SHIFT); }
+
+    // 分块中被占用的格子数
+    int tilePopulation(int tile) const { return populations[tile]; }
+
+    // 分块第 row 行的位图（未分配的块返回 0）
+    quint64 tileRow(int tile, int row) const { return tiles[tile].empty() ? 0 : tiles[tile][row]; }
+
+    // 当前已分配内存的分块数量
+    int allocatedTiles() const;
+
+private:
+    static constexpr size_t MAX_SPARE_TILES = 64; // 最多保留的空块数量
+
+    // 回收一个已清空的分块
+    void releaseTile(int t);
+
+    int gridWidth;                          // 地图宽度（格子数）
+    int gridHeight;                         // 地图高度（格子数）
+    int tileColumns;                        // 横向分块数
+    int tileRows;                           // 纵向分块数
+    std::vector<std::vector<quint64>> tiles; // 分块位图，空 vector 表示该块未分配（全部空闲）
+    std::vector<int> populations;           // 每块被占用的格子数
+    std::vector<std::vector<quint64>> spare; // 回收的空块，供下次分配复用
+};
+
+#endif // OCCUPANCYGRID_H
@@ -0,0 +1,28 @@
+#include "Random.h"
+#include <chrono>
+#include <random>
+
+Random::Random(quint64 seed) {
+    this->seed(seed);
+}
+
+void Random::seed(quint64 seed) {
+    initialSeed = seed;
+    // splitmix64：把 64 位种子扩展为 4 个互不相关的状态字
+    quint64 x = seed;
+    for (quint64& word : state) {
+        x += 0x9E3779B97F4A7C15ULL;
+        quint64 z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        word = z ^ (z >> 31);
+    }
+}
+
+quint64 Random::entropySeed() {
+    std::random_device device;
+    const quint64 hardware = (static_cast<quint64>(device()) << 32) ^ device();
+    const quint64 clock = static_cast<quint64>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+    return hardware ^ (clock * 0x9E3779B97F4A7C15ULL);
+}
@@ -0,0 +1,47 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <QtGlobal>
+
+// Random 类：每局游戏独立持有的快速伪随机数生成器（xoshiro256**）
+// 不依赖全局状态，可在多个线程中各自使用；相同种子总是产生相同的随机序列
+class Random {
+public:
+    // 构造函数：使用给定种子初始化
+    explicit Random(quint64 seed = 0);
+
+    // 重新设置种子（内部用 splitmix64 扩展为 256 位状态）
+    void seed(quint64 seed);
+
+    // 获取最近一次设置的种子
+    quint64 getSeed() const { return initialSeed; }
+
+    // 生成下一个 64 位随机数
+    quint64 next() {
+        const quint64 result = rotl(state[1] * 5, 7) * 9;
+        const quint64 t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // 生成 [0, bound) 范围内的整数（bound > 0），用乘法取高位代替取模
+    int bounded(int bound) {
+        return static_cast<int>(((next() >> 32) * static_cast<quint64>(bound)) >> 32);
+    }
+
+    // 从系统熵源生成一个新种子（用于未指定种子的对局）
+    static quint64 entropySeed();
+
+private:
+    static quint64 rotl(quint64 x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    quint64 state[4];     // xoshiro256** 内部状态
+    quint64 initialSeed;  // 初始化时使用的种子
+};
+
+#endif // RANDOM_H
@@ -0,0 +1,137 @@
+#include "Replay.h"
+#include <algorithm>
+
+namespace {
+
+const quint8 MAGIC[4] = {'S', 'N', 'K', 'R'};
+const quint8 FORMAT_VERSION = 3; // 版本 2 在帧数后增加了用时，版本 3 在用时后增加了结束时的状态散列
+
+// 写入无符号 LEB128 变长整数：每字节 7 位数据，最高位表示后面还有字节
+void writeVarint(std::vector<quint8>& out, quint64 value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<quint8>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<quint8>(value));
+}
+
+// 读取变长整数，数据不足或超过 64 位时返回 false
+bool readVarint(const quint8*& cursor, const quint8* end, quint64& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (cursor == end) return false;
+        const quint8 byte = *cursor++;
+        value |= static_cast<quint64>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+Replay::Replay()
+    : width(0), height(0), obstacleMap(false), difficulty(0), seed(0), tickCount(0), durationMillis(0),
+      finalHash(0), finalHashKnown(false) {}
+
+void Replay::begin(int width, int height, bool obstacleMap, int difficulty, quint64 seed) {
+    this->width = width;
+    this->height = height;
+    this->obstacleMap = obstacleMap;
+    this->difficulty = difficulty;
+    this->seed = seed;
+    tickCount = 0;
+    durationMillis = 0;
+    finalHash = 0;
+    finalHashKnown = false;
+    inputs.clear();
+}
+
+void Replay::record(Snake::Direction dir) {
+    if ((tickCount & 3) == 0) {
+        inputs.push_back(0);
+    }
+    inputs.back() |= static_cast<quint8>(dir & 3) << ((tickCount & 3) * 2);
+    ++tickCount;
+}
+
+std::vector<quint8> Replay::serialize() const {
+    std::vector<quint8> out(MAGIC, MAGIC + 4);
+    out.push_back(FORMAT_VERSION);
+    writeVarint(out, width);
+    writeVarint(out, height);
+    writeVarint(out, obstacleMap ? 1 : 0);
+    writeVarint(out, difficulty);
+    writeVarint(out, seed);
+    writeVarint(out, tickCount);
+    writeVarint(out, static_cast<quint64>(durationMillis));
+    writeVarint(out, finalHashKnown ? 1 : 0);
+    writeVarint(out, finalHash);
+    out.insert(out.end(), inputs.begin(), inputs.end());
+    return out;
+}
+
+bool Replay::deserialize(const quint8* data, size_t size) {
+    const quint8* cursor = data;
+    const quint8* end = data + size;
+    if (size < 5 || !std::equal(MAGIC, MAGIC + 4, data) || data[4] < 1 || data[4] > FORMAT_VERSION) return false;
+    const int fieldCount = data[4] >= 3 ? 9 : data[4] >= 2 ? 7 : 6;
+    cursor += 5;
+
+    quint64 fields[9] = {};
+    for (int i = 0; i < fieldCount; ++i) {
+        if (!readVarint(cursor, end, fields[i])) return false;
+    }
+    // 宽、高必须在 SnakeGame 允许的范围内（否则重放时会被裁剪到另一张地图），帧数必须是合理的 int；
+    // 输入流长度必须与帧数一致
+    if (fields[0] < GameCore::MIN_SIZE || fields[0] > GameCore::MAX_SIZE) return false;
+    if (fields[1] < GameCore::MIN_SIZE || fields[1] > GameCore::MAX_SIZE) return false;
+    if (fields[5] > 0x7fffffff || fields[6] > 0x7fffffffffffffffULL) return false;
+    const size_t inputBytes = static_cast<size_t>((fields[5] + 3) / 4);
+    if (static_cast<size_t>(end - cursor) != inputBytes) return false;
+
+    width = static_cast<int>(fields[0]);
+    height = static_cast<int>(fields[1]);
+    obstacleMap = fields[2] != 0;
+    difficulty = static_cast<int>(fields[3]);
+    seed = fields[4];
+    tickCount = static_cast<int>(fields[5]);
+    durationMillis = static_cast<qint64>(fields[6]);
+    finalHashKnown = fields[7] != 0;
+    finalHash = fields[8];
+    inputs.assign(cursor, end);
+    return true;
+}
+
+ReplayPlayer::ReplayPlayer(const Replay& replay)
+    : replay(replay), core(replay.getWidth(), replay.getHeight()), tick(0), consistent(true) {
+    replay.resetCore(core);
+    keyframes.reserve(replay.getTickCount() / KEYFRAME_INTERVAL + 1);
+    keyframes.push_back(core);
+    for (int t = 0; t < replay.getTickCount(); ++t) {
+        core.step(replay.inputAt(t));
+        if ((t + 1) % KEYFRAME_INTERVAL == 0) {
+            keyframes.push_back(core);
+        }
+    }
+    consistent = !replay.hasFinalHash() || core.getHash() == replay.getFinalHash();
+    core = keyframes.front();
+}
+
+void ReplayPlayer::seek(int target) {
+    target = std::clamp(target, 0, replay.getTickCount());
+    // 目标在当前位置之后且不跨快照时直接向前模拟，否则从最近的快照开始
+    const int keyframe = target / KEYFRAME_INTERVAL;
+    if (target < tick || tick < keyframe * KEYFRAME_INTERVAL) {
+        core = keyframes[keyframe];
+        tick = keyframe * KEYFRAME_INTERVAL;
+    }
+    while (tick < target) {
+        core.step(replay.inputAt(tick++));
+    }
+}
+
+bool ReplayPlayer::stepForward() {
+    if (tick >= replay.getTickCount()) return false;
+    core.step(replay.inputAt(tick++));
+    return true;
+}
\ No newline at end of file
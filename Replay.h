@@ -0,0 +1,98 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <QtGlobal>
+#include <vector>
+#include "GameCore.h"
+
+// Replay 类：一局游戏的录像 = 文件头（地图、难度、种子）+ 每个逻辑帧实际使用的方向
+// GameCore 完全由种子和输入决定，因此按相同顺序重放这些方向即可逐位复现整局游戏
+// 二进制格式："SNKR" + 版本号，随后是 varint 编码的宽、高、地图类型、难度、种子、帧数、用时（毫秒，版本 2 起）、
+// 是否记录了结束状态散列与该散列（版本 3 起），最后每帧 2 bit（4 帧一个字节，低位在前）
+class Replay {
+public:
+    // 构造函数：创建空录像
+    Replay();
+
+    // 开始录制新的一局（清空已有输入）
+    void begin(int width, int height, bool obstacleMap, int difficulty, quint64 seed);
+
+    // 追加一帧的方向（在调用 GameCore::step() 之前记录当前方向）
+    void record(Snake::Direction dir);
+
+    // 第 tick 帧使用的方向（0 <= tick < getTickCount()）
+    Snake::Direction inputAt(int tick) const {
+        return static_cast<Snake::Direction>((inputs[tick >> 2] >> ((tick & 3) * 2)) & 3);
+    }
+
+    // 录像信息
+    int getTickCount() const { return tickCount; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    bool isObstacleMap() const { return obstacleMap; }
+    int getDifficulty() const { return difficulty; }
+    quint64 getSeed() const { return seed; }
+
+    // 本局的游戏时钟用时（毫秒，结束时写入；版本 1 的录像为 0）
+    qint64 getDurationMillis() const { return durationMillis; }
+    void setDurationMillis(qint64 millis) { durationMillis = millis; }
+
+    // 录制结束时的状态散列（GameCore::getHash()）：重放到最后一帧后比较一次即可发现不同步（版本 3 之前的录像没有）
+    bool hasFinalHash() const { return finalHashKnown; }
+    quint64 getFinalHash() const { return finalHash; }
+    void setFinalHash(quint64 hash) { finalHash = hash; finalHashKnown = true; }
+
+    // 按录像开头的设置重置一局游戏（之后逐帧 step(inputAt(t)) 即可重放）
+    void resetCore(GameCore& core) const { core.reset(seed, obstacleMap); }
+
+    // 序列化为二进制数据
+    std::vector<quint8> serialize() const;
+
+    // 从二进制数据读取，格式错误或地图尺寸超出 GameCore::MIN_SIZE..MAX_SIZE 时返回 false 且不修改当前内容
+    bool deserialize(const quint8* data, size_t size);
+
+private:
+    int width;                  // 地图宽度
+    int height;                 // 地图高度
+    bool obstacleMap;           // 是否为障碍物地图
+    int difficulty;             // 难度等级（只影响界面速度，不影响逻辑）
+    quint64 seed;               // 本局随机种子
+    int tickCount;              // 已记录的帧数
+    qint64 durationMillis;      // 游戏时钟用时（毫秒）
+    quint64 finalHash;          // 录制结束时的状态散列
+    bool finalHashKnown;        // 是否记录了 finalHash
+    std::vector<quint8> inputs; // 每帧 2 bit 的方向流
+};
+
+// ReplayPlayer 类：录像播放器，加载时完整模拟一遍并每隔 KEYFRAME_INTERVAL 帧保存一份 GameCore 快照
+// 跳转到任意帧只需从最近的快照复制状态，再模拟不到 KEYFRAME_INTERVAL 帧
+class ReplayPlayer {
+public:
+    static constexpr int KEYFRAME_INTERVAL = 1024; // 快照间隔（帧）
+
+    // 构造函数：加载录像并生成快照
+    explicit ReplayPlayer(const Replay& replay);
+
+    // 跳转到第 tick 帧之后的状态（0 表示开局，超出范围时截断到录像两端）
+    void seek(int tick);
+
+    // 前进一帧，已到录像末尾时返回 false
+    bool stepForward();
+
+    // 当前帧号与当前游戏状态
+    int getTick() const { return tick; }
+    const GameCore& getCore() const { return core; }
+    const Replay& getReplay() const { return replay; }
+
+    // 加载时模拟到最后一帧的状态散列与录像记录的一致（录像没有记录散列时为 true）
+    bool isConsistent() const { return consistent; }
+
+private:
+    Replay replay;                   // 正在播放的录像
+    std::vector<GameCore> keyframes; // keyframes[i] 为第 i * KEYFRAME_INTERVAL 帧之后的状态
+    GameCore core;                   // 当前状态
+    int tick;                        // 当前帧号
+    bool consistent;                 // 重放结果与录制时一致
+};
+
+#endif // REPLAY_H
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "ReplayWriter.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <utility>
+#include <vector>
+
+ReplayWriter::ReplayWriter()
+    : dirty(false), stopRequested(false), writeCount(0), running(false) {}
+
+ReplayWriter::~ReplayWriter() {
+    close();
+}
+
+void ReplayWriter::save(const QString& file, const Replay& replay) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        path = file;
+        pending = replay;
+        dirty = true;
+        stopRequested = false;
+    }
+    if (!running) {
+        running = true;
+        worker = std::thread(&ReplayWriter::run, this);
+    }
+    wake.notify_all();
+}
+
+void ReplayWriter::close() {
+    if (!running) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    wake.notify_all();
+    worker.join();
+    running = false;
+}
+
+void ReplayWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this]() { return dirty || stopRequested; });
+        if (dirty) {
+            const QString target = path;
+            const Replay snapshot = std::move(pending);
+            dirty = false;
+            lock.unlock();
+            if (writeFile(target, snapshot)) {
+                ++writeCount;
+            } else {
+                qDebug() << "Failed to save replay:" << target;
+            }
+            lock.lock();
+        }
+        if (stopRequested && !dirty) return;
+    }
+}
+
+bool ReplayWriter::writeFile(const QString& path, const Replay& replay) {
+    const std::vector<quint8> data = replay.serialize();
+    // 首次运行时应用数据目录可能还不存在
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    // QSaveFile 写入同目录下的临时文件，commit() 时才原子地替换目标文件
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const qint64 size = static_cast<qint64>(data.size());
+    if (file.write(reinterpret_cast<const char*>(data.data()), size) != size) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
\ No newline at end of file
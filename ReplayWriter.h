@@ -0,0 +1,51 @@
+#ifndef REPLAYWRITER_H
+#define REPLAYWRITER_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Replay.h"
+
+// ReplayWriter 类：在后台线程中把录像写入文件，调用方只在内存中交出录像，不等待磁盘
+//   写入：save() 只保存一份录像副本并唤醒后台线程，序列化与写盘都在后台线程中完成；
+//         还没写出就被新的 save() 替换的录像直接丢弃（最近一局录像只需要最后一份）
+//   持久化：先创建所在目录，再写临时文件并原子重命名（QSaveFile），写到一半崩溃时旧文件保持完整
+class ReplayWriter {
+public:
+    // 构造函数：创建空闲的写入器（后台线程在第一次 save() 时启动）
+    ReplayWriter();
+
+    // 析构函数：写出尚未保存的录像并等待后台线程退出
+    ~ReplayWriter();
+
+    // 提交一份录像，由后台线程写入 path（只复制内存，立即返回）
+    void save(const QString& path, const Replay& replay);
+
+    // 写出尚未保存的录像并停止后台线程（之后再 save() 会重新启动）
+    void close();
+
+    // 后台线程已完成的写入次数（被替换而没有写出的录像不计）
+    quint64 getWriteCount() const { return writeCount.load(); }
+
+    // 同步写入：创建所在目录后用 QSaveFile 写出录像，失败时返回 false
+    static bool writeFile(const QString& path, const Replay& replay);
+
+private:
+    // 后台线程主循环：等待提交并写入
+    void run();
+
+    QString path;                  // 待写录像的路径（受 mutex 保护）
+    Replay pending;                // 待写的录像（受 mutex 保护）
+    bool dirty;                    // 有尚未写出的录像（受 mutex 保护）
+    bool stopRequested;            // 请求后台线程退出（受 mutex 保护）
+    std::mutex mutex;
+    std::condition_variable wake;  // 提交或停止时唤醒后台线程
+    std::atomic<quint64> writeCount;
+    std::thread worker;
+    bool running;
+};
+
+#endif // REPLAYWRITER_H
\ No newline at end of file
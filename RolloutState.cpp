@@ -0,0 +1,182 @@
+#include "RolloutState.h"
+#include "Zobrist.h"
+#include <QtAlgorithms>
+#include <algorithm>
+
+namespace {
+
+const int SPAWN_SAMPLES = 16; // 随机抽样放置食物的次数，都失败后改为顺序查找
+
+} // namespace
+
+void RolloutState::Obstacles::load(const GameCore& core) {
+    width = core.getWidth();
+    height = core.getHeight();
+    count = 0;
+    bits.assign((static_cast<size_t>(width) * height + 63) / 64, 0);
+    for (const QPoint& p : core.getObstacles()) {
+        const int cell = p.y() * width + p.x();
+        bits[cell >> 6] |= quint64(1) << (cell & 63);
+        ++count;
+    }
+}
+
+RolloutState::RolloutState()
+    : width(0), height(0), obstacles(nullptr), ringHead(0), length(0), growing(false),
+      food(-1), direction(Snake::Right), alive(false), hashing(true), hash(0) {}
+
+void RolloutState::load(const GameCore& core, const Obstacles* shared) {
+    width = core.getWidth();
+    height = core.getHeight();
+    obstacles = shared;
+    const int cells = width * height;
+    ring.assign(cells, 0);
+    occupied.assign((cells + 63) / 64, 0);
+    const Snake& snake = core.getSnake();
+    length = snake.getLength();
+    ringHead = 0;
+    for (int i = 0; i < length; ++i) {
+        ring[i] = static_cast<int>(snake.cellAt(i));
+        setOccupied(ring[i]);
+    }
+    growing = snake.isGrowing();
+    const QPoint position = core.getFood().getPosition();
+    food = position.x() < 0 ? -1 : position.y() * width + position.x();
+    direction = snake.getDirection();
+    alive = !core.isGameOver();
+    hashing = true;
+    hash = core.getHash();
+}
+
+void RolloutState::copyFrom(const RolloutState& other) {
+    width = other.width;
+    height = other.height;
+    obstacles = other.obstacles;
+    const int cells = width * height;
+    if (static_cast<int>(ring.size()) != cells) ring.resize(cells);
+    // 蛇身按顺序搬到 ring 开头，只复制 length 个格子
+    const int first = std::min(other.length, cells - other.ringHead);
+    std::copy(other.ring.begin() + other.ringHead, other.ring.begin() + other.ringHead + first, ring.begin());
+    std::copy(other.ring.begin(), other.ring.begin() + (other.length - first), ring.begin() + first);
+    ringHead = 0;
+    length = other.length;
+    growing = other.growing;
+    occupied = other.occupied;
+    food = other.food;
+    direction = other.direction;
+    alive = other.alive;
+    hashing = other.hashing;
+    hash = other.hash;
+}
+
+int RolloutState::neighbor(Snake::Direction dir) const {
+    const int head = ring[ringHead];
+    const int x = head % width;
+    switch (dir) {
+        case Snake::Up:    return head >= width ? head - width : -1;
+        case Snake::Down:  return head + width < width * height ? head + width : -1;
+        case Snake::Left:  return x > 0 ? head - 1 : -1;
+        case Snake::Right: return x + 1 < width ? head + 1 : -1;
+    }
+    return -1;
+}
+
+bool RolloutState::isSafe(Snake::Direction dir) const {
+    if (Snake::isOpposite(dir, direction)) return false;
+    const int next = neighbor(dir);
+    if (next < 0 || obstacles->test(next)) return false;
+    // 不在增长时蛇尾会先空出，蛇头可以进入当前的蛇尾格子
+    const int tail = ring[(ringHead + length - 1) % static_cast<int>(ring.size())];
+    return !isOccupied(next) || (!growing && next == tail);
+}
+
+quint64 RolloutState::hashAfter(Snake::Direction dir) const {
+    const int capacity = static_cast<int>(ring.size());
+    const int next = neighbor(dir);
+    const int tail = ring[(ringHead + length - 1) % capacity];
+    quint64 after = hash ^ Zobrist::direction(direction) ^ Zobrist::direction(dir)
+                  ^ Zobrist::head(ring[ringHead]) ^ Zobrist::tail(tail) ^ Zobrist::body(next) ^ Zobrist::head(next);
+    if (growing) return after ^ Zobrist::growing() ^ Zobrist::tail(tail);
+    // 蛇尾空出：新蛇尾为倒数第二节，只有一节时为新蛇头
+    after ^= Zobrist::body(tail);
+    return after ^ Zobrist::tail(length > 1 ? ring[(ringHead + length - 2) % capacity] : next);
+}
+
+RolloutState::Result RolloutState::step(Snake::Direction dir, Random& rng) {
+    const int capacity = static_cast<int>(ring.size());
+    const int oldHead = ring[ringHead];
+    const int oldTail = ring[(ringHead + length - 1) % capacity];
+    const Snake::Direction oldDirection = direction;
+    const bool wasGrowing = growing;
+    const int oldFood = food;
+
+    if (!Snake::isOpposite(dir, direction)) direction = dir;
+    const int next = neighbor(direction);
+    if (next < 0) {
+        alive = false;
+        return Died;
+    }
+    // 先移除蛇尾再判断占用，与 Snake::move() 相同
+    if (growing) {
+        growing = false;
+    } else {
+        clearOccupied(oldTail);
+        --length;
+    }
+    if (isOccupied(next) || obstacles->test(next)) {
+        alive = false;
+        return Died;
+    }
+    ringHead = ringHead == 0 ? capacity - 1 : ringHead - 1;
+    ring[ringHead] = next;
+    ++length;
+    setOccupied(next);
+    Result result = Moved;
+    if (next == food) {
+        growing = true;
+        result = spawnFood(rng) ? AteFood : Filled;
+    }
+
+    if (hashing) {
+        // 与 Snake::move()、Snake::grow()、Food::respawn() 对散列的增量更新相同
+        hash ^= Zobrist::direction(oldDirection) ^ Zobrist::direction(direction)
+              ^ Zobrist::head(oldHead) ^ Zobrist::tail(oldTail) ^ Zobrist::body(next) ^ Zobrist::head(next)
+              ^ Zobrist::tail(ring[(ringHead + length - 1) % capacity]);
+        hash ^= wasGrowing ? Zobrist::growing() : Zobrist::body(oldTail);
+        if (growing) hash ^= Zobrist::growing();
+        if (food != oldFood) {
+            hash ^= Zobrist::food(oldFood);
+            if (food >= 0) hash ^= Zobrist::food(food);
+        }
+    }
+    return result;
+}
+
+bool RolloutState::spawnFood(Random& rng) {
+    const int cells = width * height;
+    if (cells - obstacles->count - length <= 0) {
+        food = -1;
+        return false;
+    }
+    for (int i = 0; i < SPAWN_SAMPLES; ++i) {
+        const int cell = rng.bounded(cells);
+        if (!isOccupied(cell) && !obstacles->test(cell)) {
+            food = cell;
+            return true;
+        }
+    }
+    // 地图快满时抽样大多落空：从随机起点按位图逐字查找第一个空格子
+    const int words = static_cast<int>(occupied.size());
+    const int start = rng.bounded(words);
+    for (int k = 0; k < words; ++k) {
+        const int w = (start + k) % words;
+        quint64 free = ~(occupied[w] | obstacles->bits[w]);
+        if (w == words - 1 && (cells & 63)) free &= (quint64(1) << (cells & 63)) - 1;
+        if (free) {
+            food = (w << 6) + static_cast<int>(qCountTrailingZeroBits(free));
+            return true;
+        }
+    }
+    food = -1;
+    return false;
+}
\ No newline at end of file
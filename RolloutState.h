@@ -0,0 +1,96 @@
+#ifndef ROLLOUTSTATE_H
+#define ROLLOUTSTATE_H
+
+#include <QtGlobal>
+#include <vector>
+#include "GameCore.h"
+#include "Random.h"
+
+// RolloutState 类：供树搜索反复克隆、推进的紧凑游戏状态，规则与 GameCore::step() 一致
+// 蛇身是从下标 0 起按蛇头到蛇尾存放的格子编号环形缓冲区，占用是一维位图；障碍物位图只读、
+// 由同一次决策的所有状态共享（指针），克隆时不复制。克隆只复制蛇身与占用位图，缓冲区在第一次
+// copyFrom() 后容量固定，此后克隆与推进都不分配内存
+// 吃到食物后新食物由调用方提供的随机数生成器在空格子上随机放置（搜索不能预知真实对局的下一个食物），
+// 先随机抽样若干次，都落在占用格子上时再从随机起点顺序查找
+class RolloutState {
+public:
+    // 推进一步的结果
+    enum Result {
+        Moved,     // 正常移动
+        AteFood,   // 吃到食物
+        Died,      // 撞墙、撞到自己或障碍物
+        Filled     // 吃到食物后地图已满
+    };
+
+    // 按行展开的障碍物位图（第 y * width + x 位），一次决策内所有状态共享
+    struct Obstacles {
+        int width = 0;
+        int height = 0;
+        int count = 0;               // 障碍物格子数
+        std::vector<quint64> bits;
+
+        // 从 core 的障碍物地图重建（地图尺寸不变时不重新分配）
+        void load(const GameCore& core);
+
+        bool test(int cell) const { return (bits[cell >> 6] >> (cell & 63)) & 1; }
+    };
+
+    RolloutState();
+
+    // 从真实对局复制状态，obstacles 必须由同一个 core 构建并在本状态使用期间保持有效
+    void load(const GameCore& core, const Obstacles* obstacles);
+
+    // 克隆另一个状态（共享同一份障碍物位图）
+    void copyFrom(const RolloutState& other);
+
+    // 沿 dir 推进一步（与当前方向相反时保持原方向，与 Snake::setDirection() 相同）
+    Result step(Snake::Direction dir, Random& rng);
+
+    // 沿 dir 走一步后蛇头所在的格子编号，出界时返回 -1（不考虑掉头）
+    int neighbor(Snake::Direction dir) const;
+
+    // 沿 dir 走一步是否不会立即死亡（掉头视为不安全）
+    bool isSafe(Snake::Direction dir) const;
+
+    // 状态散列，与同一局面下的 GameCore::getHash() 相同，随 step() 增量维护
+    quint64 getHash() const { return hash; }
+
+    // 关闭散列维护（推演阶段不再查置换表，省去每步的键计算；之后 getHash() 无效，load() / copyFrom() 恢复）
+    void stopHashing() { hashing = false; }
+
+    // 沿安全方向 dir 走一步、且没有吃到食物时的状态散列（不修改状态，O(1)）
+    quint64 hashAfter(Snake::Direction dir) const;
+
+    // 基本信息
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getHead() const { return ring[ringHead]; }
+    int getFood() const { return food; }
+    int getLength() const { return length; }
+    Snake::Direction getDirection() const { return direction; }
+    bool isAlive() const { return alive; }
+
+private:
+    // 在空格子上随机放置新食物，地图已满时返回 false
+    bool spawnFood(Random& rng);
+
+    bool isOccupied(int cell) const { return (occupied[cell >> 6] >> (cell & 63)) & 1; }
+    void setOccupied(int cell) { occupied[cell >> 6] |= quint64(1) << (cell & 63); }
+    void clearOccupied(int cell) { occupied[cell >> 6] &= ~(quint64(1) << (cell & 63)); }
+
+    int width;
+    int height;
+    const Obstacles* obstacles;
+    std::vector<int> ring;           // 蛇身格子编号（容量为格子数）
+    int ringHead;                    // 蛇头在 ring 中的下标
+    int length;
+    bool growing;                    // 下一步不移除蛇尾（与 Snake::grow() 相同）
+    std::vector<quint64> occupied;   // 蛇身占用位图
+    int food;                        // 食物格子编号，地图已满时为 -1
+    Snake::Direction direction;
+    bool alive;
+    bool hashing;                    // 是否维护 hash
+    quint64 hash;                    // 状态散列（见 Zobrist）
+};
+
+#endif // ROLLOUTSTATE_H
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "SimulationThread.h"
+#include <algorithm>
+#include <chrono>
+
+SimulationThread::SimulationThread()
+    : replaying(false), replayTick(0), pendingCount(0), autopilotUsed(false), stopRequested(false),
+      autopilotMode(AUTOPILOT_OFF), running(false) {}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start(const GameCore& initial, const Replay& record, bool replay, int tick, qint64 stepNanos) {
+    stop();
+    core = initial;
+    this->replay = record;
+    replaying = replay;
+    replayTick = tick;
+    stats = TickStats();
+    inputStats = InputStats();
+    pendingCount = 0;
+    autopilotUsed = false;
+    inputs.clear();
+    stopRequested.store(false);
+
+    // 线程启动前三个缓冲区都是初始状态，界面在第一帧发布前也能读到有效快照
+    Frame first;
+    capture(first);
+    frames.reset(first);
+
+    clock.start(stepNanos);
+    running = true;
+    worker = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    if (!running) return;
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopRequested.store(true);
+    }
+    wake.notify_all();
+    worker.join();
+    running = false;
+}
+
+qreal SimulationThread::interpolation() const {
+    const qint64 step = clock.step();
+    if (step <= 0) return 0.0;
+    const qreal alpha = qreal(clock.elapsed() - frame().dueNanos) / step;
+    return std::clamp(alpha, 0.0, 1.0);
+}
+
+void SimulationThread::run() {
+    while (waitForNextTick()) {
+        const int due = clock.advance();
+        if (due == 0) continue;
+        // 本批第 k 帧的计划时刻比最后一帧早 (due - 1 - k) 个步长，抖动随之递减
+        const qint64 lastDue = clock.lastTickDue();
+        const qint64 now = clock.elapsed();
+        for (int k = 0; k < due; ++k) {
+            const qint64 dueNanos = lastDue - static_cast<qint64>(due - 1 - k) * clock.step();
+            const qint64 jitter = now - dueNanos;
+            ++stats.ticks;
+            stats.totalJitterNanos += jitter;
+            stats.maxJitterNanos = std::max(stats.maxJitterNanos, jitter);
+            if (jitter >= clock.step()) ++stats.lateTicks;
+            const bool alive = tick(now);
+            stats.droppedTicks = clock.droppedTicks();
+            publish(dueNanos, !alive);
+            if (!alive) return;
+        }
+    }
+}
+
+bool SimulationThread::waitForNextTick() {
+    const qint64 remaining = clock.untilNextTick();
+    if (remaining > SPIN_NANOS) {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        if (wake.wait_for(lock, std::chrono::nanoseconds(remaining - SPIN_NANOS),
+                          [this]() { return stopRequested.load(); })) {
+            return false;
+        }
+    }
+    while (clock.untilNextTick() > 0) {
+        if (stopRequested.load(std::memory_order_relaxed)) return false;
+        std::this_thread::yield();
+    }
+    return !stopRequested.load();
+}
+
+bool SimulationThread::tick(qint64 now) {
+    if (replaying) {
+        if (replayTick >= replay.getTickCount()) {
+            return false; // 录像结束（例如录制时中途退出）
+        }
+        core.setDirection(replay.inputAt(replayTick++));
+    } else {
+        applyBufferedTurn(now);
+        // 自动驾驶对即将推进的这一帧做决策（覆盖玩家的转向），不会作用到更晚的局面上
+        const int mode = autopilotMode.load(std::memory_order_relaxed);
+        if (mode != AUTOPILOT_OFF) {
+            const Autopilot::Strategy strategy = static_cast<Autopilot::Strategy>(mode);
+            if (autopilot.getStrategy() != strategy) autopilot.setStrategy(strategy);
+            core.setDirection(autopilot.choose(core));
+            autopilotUsed = true;
+        }
+        replay.record(core.getSnake().getDirection());
+    }
+    core.step();
+    return !core.isGameOver();
+}
+
+void SimulationThread::applyBufferedTurn(qint64 now) {
+    TurnInput input;
+    while (inputs.pop(input)) {
+        if (pendingCount == MAX_BUFFERED_TURNS) {
+            ++inputStats.droppedTurns;
+            continue;
+        }
+        pendingTurns[pendingCount] = input;
+        pendingDeferred[pendingCount] = false;
+        ++pendingCount;
+    }
+
+    // 每帧只采用一个转向：一帧内连按两次（例如向右走时按上再按左）时第二次留到下一帧，
+    // 而不是在蛇还没走动时就以第一次的方向为准判断掉头。与当前方向相同或相反的输入直接跳过
+    const Snake::Direction current = core.getSnake().getDirection();
+    int used = 0;
+    while (used < pendingCount) {
+        const TurnInput& turn = pendingTurns[used];
+        const bool deferred = pendingDeferred[used];
+        ++used;
+        if (turn.dir == current || Snake::isOpposite(turn.dir, current)) {
+            ++inputStats.ignoredTurns;
+            continue;
+        }
+        core.setDirection(turn.dir);
+        inputStats.latency.add(now - turn.timestampNanos);
+        if (deferred) ++inputStats.deferredTurns;
+        break;
+    }
+    pendingCount -= used;
+    for (int i = 0; i < pendingCount; ++i) {
+        pendingTurns[i] = pendingTurns[i + used];
+        pendingDeferred[i] = true;
+    }
+}
+
+void SimulationThread::capture(Frame& frame) const {
+    frame.snake = core.getSnake();
+    frame.food = core.getFood();
+    frame.score = core.getScore();
+    frame.tickCount = core.getTickCount();
+    frame.gameOver = core.isGameOver();
+    frame.boardComplete = core.isBoardComplete();
+    frame.autopilotUsed = autopilotUsed;
+    frame.autopilotOnCycle = autopilot.isOnCycle();
+}
+
+void SimulationThread::publish(qint64 dueNanos, bool finished) {
+    Frame& next = frames.writeBuffer();
+    capture(next);
+    next.dueNanos = dueNanos;
+    next.finished = finished;
+    next.stats = stats;
+    next.input = inputStats;
+    frames.publish();
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Autopilot.h"
+#include "FixedTimestep.h"
+#include "GameCore.h"
+#include "LatencyHistogram.h"
+#include "Replay.h"
+#include "SpscQueue.h"
+#include "TripleBuffer.h"
+
+// SimulationThread 类：在独立线程中按固定步长推进一局游戏，与界面线程只通过无锁结构交换数据
+//   界面 -> 模拟：方向输入带上时间戳走 SpscQueue，进入模拟线程的有界转向缓冲，每个逻辑帧最多采用一个
+//   模拟 -> 界面：每个逻辑帧之后把绘制需要的动态状态（蛇、食物、得分、帧号）写入 TripleBuffer 并发布，
+//                界面在绘制前 poll() 取最新快照；地图尺寸、种子与障碍物在一次运行中不变，界面从 start() 的参数读取，
+//                因此每帧复制的数据量只与蛇长有关，与地图大小无关
+// 自动驾驶开启时在模拟线程中对每个逻辑帧即将推进的局面做决策，决策总是作用于它所依据的那一帧
+// 绘制卡顿或磁盘读写只会让界面少取几个快照，不会推迟逻辑帧；逻辑帧按单调时钟定时，先休眠到
+// 到期前 SPIN_NANOS，再短暂自旋到到期时刻，减小操作系统定时器精度带来的抖动
+class SimulationThread {
+public:
+    static constexpr qint64 SPIN_NANOS = 1000000; // 到期前最后 1 ms 改为自旋等待
+    static constexpr size_t INPUT_QUEUE_SIZE = 64; // 输入队列容量（远大于一帧内可能的按键数）
+    static constexpr int MAX_BUFFERED_TURNS = 3;    // 等待生效的转向最多缓冲几个（再多的按键丢弃）
+    static constexpr int AUTOPILOT_OFF = -1;        // autopilotMode 的取值：关闭自动驾驶
+
+    // 一个方向输入：方向与按键时刻（相对 start()，与逻辑帧同一单调时钟）
+    struct TurnInput {
+        Snake::Direction dir;
+        qint64 timestampNanos;
+    };
+
+    // 方向输入的统计：延迟 = 转向实际生效的逻辑帧执行时刻 - 按键时刻
+    struct InputStats {
+        LatencyHistogram latency;  // 生效输入的延迟分布
+        quint64 deferredTurns = 0; // 排在其他转向之后、没能在到达后的第一帧生效的输入数
+        quint64 ignoredTurns = 0;  // 与当时方向相同或相反而被跳过的输入数
+        quint64 droppedTurns = 0;  // 缓冲已满被丢弃的输入数
+    };
+
+    // 逻辑帧的定时统计（抖动 = 实际执行时刻 - 计划时刻）
+    struct TickStats {
+        quint64 ticks = 0;           // 已执行的逻辑帧数
+        quint64 lateTicks = 0;       // 迟到一个步长以上的帧数
+        quint64 droppedTicks = 0;    // 积压过多被丢弃的帧数
+        qint64 totalJitterNanos = 0; // 抖动总和
+        qint64 maxJitterNanos = 0;   // 最大抖动
+
+        // 平均抖动（纳秒）
+        qint64 meanJitterNanos() const { return ticks ? totalJitterNanos / static_cast<qint64>(ticks) : 0; }
+    };
+
+    // 一个逻辑帧之后的不可变快照（只含一局之中会变化的状态）
+    struct Frame {
+        Snake snake;               // 蛇（环形缓冲区与占用位图）
+        Food food;                 // 食物
+        int score = 0;             // 得分
+        quint64 tickCount = 0;     // 已推进的逻辑帧数
+        bool gameOver = false;     // 游戏是否已结束
+        bool boardComplete = false; // 是否已填满地图
+        qint64 dueNanos = 0;       // 本帧的计划时刻（相对 start()，用于界面插值）
+        bool finished = false;     // 模拟已结束（游戏结束或录像放完），线程随后退出
+        bool autopilotUsed = false;    // 自 start() 起自动驾驶是否决定过方向
+        bool autopilotOnCycle = false; // 自动驾驶当前是否正沿哈密顿回路行走
+        TickStats stats;           // 截至本帧的定时统计
+        InputStats input;          // 截至本帧的输入统计
+    };
+
+    // 构造函数：创建未运行的模拟线程
+    SimulationThread();
+
+    // 析构函数：停止并等待线程结束
+    ~SimulationThread();
+
+    // 从 core 的当前状态开始模拟（步长 stepNanos）：replaying 为 true 时从 replay 第 replayTick 帧起
+    // 读取方向，否则把每帧实际使用的方向追加到 replay 中；已在运行时先停止
+    void start(const GameCore& core, const Replay& replay, bool replaying, int replayTick, qint64 stepNanos);
+
+    // 请求停止并等待线程退出；之后可通过 getCore() 等取回最终状态
+    void stop();
+
+    // 线程是否已启动且尚未被 stop()（线程自己因游戏结束退出后仍为 true，直到 stop()）
+    bool isRunning() const { return running; }
+
+    // 界面线程：提交一个方向输入，以当前时刻为按键时刻（队列满时丢弃并返回 false）
+    bool pushInput(Snake::Direction dir) { return inputs.push(TurnInput{dir, clock.elapsed()}); }
+
+    // 界面线程：开关自动驾驶并选择策略，从下一个逻辑帧起生效（重放时忽略；可在 start() 之前设置）
+    void setAutopilot(bool enabled, Autopilot::Strategy strategy) {
+        autopilotMode.store(enabled ? static_cast<int>(strategy) : AUTOPILOT_OFF);
+    }
+
+    // 界面线程：取最新发布的快照，有新快照时返回 true
+    bool poll() { return frames.acquire(); }
+
+    // 界面线程：当前快照（在下一次 poll() 之前保持不变）
+    const Frame& frame() const { return frames.readBuffer(); }
+
+    // 界面线程：当前时刻在快照帧与下一帧之间的位置 [0, 1]
+    qreal interpolation() const;
+
+    // stop() 之后：最终的游戏状态、录像与重放进度
+    const GameCore& getCore() const { return core; }
+    const Replay& getReplay() const { return replay; }
+    int getReplayTick() const { return replayTick; }
+
+private:
+    // 线程主循环
+    void run();
+
+    // 执行一个逻辑帧（读取输入或录像、自动驾驶决策、推进），now 为执行时刻，返回 false 表示模拟结束
+    bool tick(qint64 now);
+
+    // 把新到的输入移入转向缓冲，再取出第一个有效转向应用到 core（now 为本帧执行时刻）
+    void applyBufferedTurn(qint64 now);
+
+    // 休眠到下一帧到期（收到停止请求时提前返回 false）
+    bool waitForNextTick();
+
+    // 把当前状态中会变化的部分复制到 frame（复制到同一个缓冲区时复用其内存）
+    void capture(Frame& frame) const;
+
+    // 把当前状态写入后台缓冲区并发布
+    void publish(qint64 dueNanos, bool finished);
+
+    // 以下成员在线程运行期间只由模拟线程访问
+    GameCore core;
+    Replay replay;
+    bool replaying;
+    int replayTick;
+    FixedTimestep clock;
+    TickStats stats;
+    InputStats inputStats;
+    TurnInput pendingTurns[MAX_BUFFERED_TURNS]; // 等待生效的转向（按到达顺序）
+    bool pendingDeferred[MAX_BUFFERED_TURNS];   // 对应转向是否已经错过过一帧
+    int pendingCount;
+    Autopilot autopilot;                        // 自动驾驶（搜索缓冲区在第一次决策时按地图尺寸分配）
+    bool autopilotUsed;
+
+    // 线程间共享
+    TripleBuffer<Frame> frames;                           // 模拟 -> 界面
+    SpscQueue<TurnInput, INPUT_QUEUE_SIZE> inputs;        // 界面 -> 模拟
+    std::atomic<bool> stopRequested;
+    std::atomic<int> autopilotMode;                       // 界面 -> 模拟：AUTOPILOT_OFF 或 Autopilot::Strategy
+    std::mutex wakeMutex;                                 // 只用于让休眠中的线程及时响应 stop()
+    std::condition_variable wake;
+
+    std::thread worker;
+    bool running;
+};
+
+#endif // SIMULATIONTHREAD_H
\ No newline at end of file
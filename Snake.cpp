@@ -1,65 +1,104 @@
 #include "Snake.h"
+#include "Zobrist.h"
+#include <algorithm>
 
-Snake::Snake() {
+Snake::Snake(int width, int height)
+    : capacity(std::min(width * height + 1, INITIAL_RING_CAPACITY)),
+      maxCapacity(width * height + 1), occupancy(width, height) {
+    ring.resize(capacity);
     reset();
 }
 
 void Snake::reset() {
-    body.clear();
-    body.push_back(QPoint(10, 10));
+    occupancy.clear();
+    head = QPoint(occupancy.width() / 2, occupancy.height() / 2);
+    ringHead = 0;
+    ring[ringHead] = toCell(head);
+    length = 1;
+    occupancy.set(head);
     direction = Right;
     growFlag = false;
+    selfCollision = false;
+    vacatedTail = false;
+    vacatedCell = 0;
+    stateHash = Zobrist::body(ring[ringHead]) ^ Zobrist::head(ring[ringHead]) ^ Zobrist::tail(ring[ringHead])
+              ^ Zobrist::direction(direction);
 }
 
 void Snake::setDirection(Direction dir) {
     // Prevent reversing direction
-    if ((direction == Up && dir == Down) ||
-        (direction == Down && dir == Up) ||
-        (direction == Left && dir == Right) ||
-        (direction == Right && dir == Left)) {
+    if (isOpposite(direction, dir)) {
         return;
     }
+    stateHash ^= Zobrist::direction(direction) ^ Zobrist::direction(dir);
     direction = dir;
 }
 
+bool Snake::isOpposite(Direction a, Direction b) {
+    return (a == Up && b == Down) || (a == Down && b == Up)
+        || (a == Left && b == Right) || (a == Right && b == Left);
+}
+
 Snake::Direction Snake::getDirection() const {
     return direction;
 }
 
 void Snake::move() {
-    QPoint head = getHead();
     switch (direction) {
         case Up:    head.ry() -= 1; break;
         case Down:  head.ry() += 1; break;
         case Left:  head.rx() -= 1; break;
         case Right: head.rx() += 1; break;
     }
-    body.push_front(head);
+    // 散列中的蛇头、蛇尾键先按移动前的位置去掉，移动后再按新位置加上
+    if (length > 0) stateHash ^= Zobrist::head(cellAt(0)) ^ Zobrist::tail(cellAt(length - 1));
+    // 先移除尾部再判断占用：蛇头进入刚空出的尾部格子不算自撞
+    vacatedTail = false;
     if (growFlag) {
         growFlag = false;
-    } else {
-        body.pop_back();
+        stateHash ^= Zobrist::growing();
+    } else if (length > 0) {
+        vacatedCell = cellAt(length - 1);
+        vacatedTail = true;
+        occupancy.reset(toPoint(vacatedCell));
+        stateHash ^= Zobrist::body(vacatedCell);
+        --length;
+    }
+    selfCollision = occupancy.test(head);
+    // 越界的蛇头无法打包成格子编号，不写入缓冲区（此时游戏已结束）
+    if (occupancy.contains(head)) {
+        if (length == capacity) {
+            growRing();
+        }
+        ringHead = ringHead == 0 ? capacity - 1 : ringHead - 1;
+        ring[ringHead] = toCell(head);
+        ++length;
+        occupancy.set(head);
+        stateHash ^= Zobrist::body(ring[ringHead]);
     }
+    if (length > 0) stateHash ^= Zobrist::head(cellAt(0)) ^ Zobrist::tail(cellAt(length - 1));
+}
+
+void Snake::growRing() {
+    // 按蛇头到蛇尾的顺序搬到新缓冲区的开头
+    std::vector<CellIndex> larger(std::min(capacity * 2, maxCapacity));
+    for (int i = 0; i < length; ++i) {
+        larger[i] = cellAt(i);
+    }
+    ring.swap(larger);
+    capacity = static_cast<int>(ring.size());
+    ringHead = 0;
 }
 
 void Snake::grow() {
+    if (!growFlag) stateHash ^= Zobrist::growing();
     growFlag = true;
 }
 
 bool Snake::checkSelfCollision() const {
-    const QPoint& head = getHead();
-    for (size_t i = 1; i < body.size(); ++i) {
-        if (body[i] == head) {
-            return true;
-        }
-    }
-    return false;
-}
-
-const std::deque<QPoint>& Snake::getBody() const {
-    return body;
+    return selfCollision;
 }
 
 QPoint Snake::getHead() const {
-    return body.front();
+    return head;
 }
\ No newline at end of file
@@ -2,7 +2,10 @@
 #define SNAKE_H
 
 #include <QPoint>
-#include <deque>
+#include <QtGlobal>
+#include <iterator>
+#include <vector>
+#include "OccupancyGrid.h"
 
 // Snake 类：表示贪吃蛇对象，负责管理蛇的身体、移动、增长与自撞检测等
 class Snake {
@@ -10,15 +13,63 @@ public:
     // 枚举类型：蛇的移动方向
     enum Direction { Up, Down, Left, Right };
 
-    // 构造函数：初始化蛇的位置与方向
-    Snake();
+    // 打包后的格子编号（y * width + x），32 位以支持最大 4096x4096 的地图
+    typedef quint32 CellIndex;
+
+    // BodyView 类：蛇身的只读视图，按蛇头到蛇尾的顺序把环形缓冲区中的格子编号还原为坐标
+    // 提供与原先 std::deque<QPoint> 相同的常用接口（size、operator[]、front、back、范围 for）
+    class BodyView {
+    public:
+        class const_iterator {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef QPoint value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const QPoint* pointer;
+            typedef QPoint reference;
+
+            const_iterator(const Snake* snake, int pos, int remaining)
+                : snake(snake), pos(pos), remaining(remaining) {}
+            QPoint operator*() const { return snake->toPoint(snake->ring[pos]); }
+            const_iterator& operator++() {
+                if (++pos == snake->capacity) pos = 0;
+                --remaining;
+                return *this;
+            }
+            bool operator==(const const_iterator& other) const { return remaining == other.remaining; }
+            bool operator!=(const const_iterator& other) const { return remaining != other.remaining; }
+
+        private:
+            const Snake* snake;
+            int pos;        // 当前在环形缓冲区中的位置
+            int remaining;  // 剩余未访问的节数
+        };
+
+        explicit BodyView(const Snake* snake) : snake(snake) {}
+        size_t size() const { return static_cast<size_t>(snake->length); }
+        bool empty() const { return snake->length == 0; }
+        QPoint operator[](size_t i) const { return snake->toPoint(snake->cellAt(static_cast<int>(i))); }
+        QPoint front() const { return (*this)[0]; }
+        QPoint back() const { return (*this)[size() - 1]; }
+        const_iterator begin() const { return const_iterator(snake, snake->ringHead, snake->length); }
+        const_iterator end() const { return const_iterator(snake, snake->ringHead, 0); }
+
+    private:
+        const Snake* snake;
+    };
+
+    // 构造函数：初始化蛇的位置与方向（width/height 为地图尺寸，用于占用位图与环形缓冲区容量）
+    Snake(int width = 20, int height = 20);
 
     // 重置蛇的状态（用于重新开始游戏）
     void reset();
 
-    // 设置蛇的移动方向
+    // 设置蛇的移动方向（与当前方向相反时忽略）
     void setDirection(Direction dir);
 
+    // 判断两个方向是否相反（蛇不能直接掉头）
+    static bool isOpposite(Direction a, Direction b);
+
     // 获取当前的移动方向
     Direction getDirection() const;
 
@@ -28,19 +79,65 @@ public:
     // 吃食物后调用，使蛇在下一次移动时增长一节
     void grow();
 
-    // 检查蛇是否与自身发生碰撞（头部撞到身体）
+    // 是否会在下一次移动时增长（刚吃到食物，下一次移动时尾部不动）
+    bool isGrowing() const { return growFlag; }
+
+    // 检查蛇是否与自身发生碰撞（头部撞到身体），结果在 move() 中由占用位图 O(1) 得出
     bool checkSelfCollision() const;
 
-    // 获取蛇的身体部分（返回常引用）
-    const std::deque<QPoint>& getBody() const;
+    // 判断某个格子是否被蛇身占用（O(1)）
+    bool isOccupied(const QPoint& cell) const { return occupancy.test(cell); }
+
+    // 获取蛇身占用位图（只读）
+    const OccupancyGrid& getOccupancy() const { return occupancy; }
 
-    // 获取蛇头位置（即身体的前端）
+    // 获取蛇的身体部分（蛇头到蛇尾的只读视图）
+    BodyView getBody() const { return BodyView(this); }
+
+    // 获取身体长度（节数）
+    int getLength() const { return length; }
+
+    // 获取第 i 节（0 为蛇头）的打包格子编号
+    CellIndex cellAt(int i) const {
+        int pos = ringHead + i;
+        if (pos >= capacity) pos -= capacity;
+        return ring[pos];
+    }
+
+    // 蛇的状态散列：蛇身格子、蛇头、蛇尾、方向与增长标志的 Zobrist 键异或，随状态变化 O(1) 增量维护
+    quint64 getHash() const { return stateHash; }
+
+    // 获取蛇头位置（撞墙后为地图外的坐标）
     QPoint getHead() const;
 
+    // 最近一次 move() 是否空出了尾部格子（未增长时为 true），以及空出的格子坐标
+    bool hasVacatedTail() const { return vacatedTail; }
+    QPoint getVacatedTail() const { return toPoint(vacatedCell); }
+
 private:
-    std::deque<QPoint> body;    // 使用双端队列存储蛇身的各个关节坐标，front 是蛇头，back 是蛇尾
-    Direction direction;        // 当前移动方向
-    bool growFlag;              // 是否在下一次移动时增长（由吃食物触发）
+    // 环形缓冲区初始容量上限：小地图一次分配到位，大地图随蛇身变长按倍数扩容
+    static constexpr int INITIAL_RING_CAPACITY = 4096;
+
+    // 蛇身长度达到容量时扩容（只在增长时发生，不影响普通移动）
+    void growRing();
+
+    // 格子编号与坐标互相转换
+    QPoint toPoint(CellIndex cell) const { return QPoint(cell % occupancy.width(), cell / occupancy.width()); }
+    CellIndex toCell(const QPoint& p) const { return static_cast<CellIndex>(p.y() * occupancy.width() + p.x()); }
+
+    std::vector<CellIndex> ring; // 环形缓冲区，保存蛇身各节的格子编号（普通移动时不分配内存）
+    int capacity;                // 环形缓冲区当前容量
+    int maxCapacity;             // 环形缓冲区容量上限（地图格子数 + 1）
+    int ringHead;                // 蛇头在环形缓冲区中的位置，蛇身沿下标递增方向排列
+    int length;                  // 蛇身节数
+    QPoint head;                 // 蛇头坐标（撞墙时会越出地图，不能写入缓冲区）
+    Direction direction;         // 当前移动方向
+    bool growFlag;               // 是否在下一次移动时增长（由吃食物触发）
+    bool selfCollision;          // 最近一次移动后蛇头是否撞到自身
+    bool vacatedTail;            // 最近一次移动是否空出了尾部格子
+    CellIndex vacatedCell;       // 最近一次移动空出的尾部格子
+    OccupancyGrid occupancy;     // 蛇身占用位图，随 move() 增量维护
+    quint64 stateHash;           // 状态散列（见 Zobrist），随 move()、grow()、setDirection() 增量维护
 };
 
 #endif // SNAKE_H
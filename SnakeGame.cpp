@@ -1,108 +1,58 @@
 #include "SnakeGame.h"
 #include <QKeyEvent>
-#include <QTimer>
 #include <QFile>
-#include <QTextStream>
 #include <QStandardPaths>
 #include <QDateTime>
 #include <QtGlobal>
-#include <cstdlib> // For srand and rand
 #include <QUrl>
 #include <QDir>
-#include <ctime>   // For time
-
-const int GRID_WIDTH = 20;
-const int GRID_HEIGHT = 20;
+#include <algorithm>
 
 SnakeGame::SnakeGame(QObject *parent)
-    : QObject(parent), score(0), gameOverFlag(false), gameState(Menu), difficulty(1), elapsedTime(0), highScore(0){
-    loadHighScore();
-    qDebug() << "High Score loaded:" << highScore;
-    srand(time(0)); // Seed random number generator
-    // Start a timer for elapsed time
-    QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, [this]() {
-    // 只有在游戏进行中且已按下第一个按键时才计时
-    if (gameState == Playing && !waitingForFirstMove) {
-        elapsedTime++;
-    }
-});
-    timer->start(1000); // Update every second
+    : QObject(parent), core(DEFAULT_BOARD_SIZE, DEFAULT_BOARD_SIZE), gameState(Menu), difficulty(1), highScore(0), leaderboardRank(0),
+      pendingSeed(0), hasPendingSeed(false), waitingForFirstMove(false), paused(false),
+      replayPending(false), replaying(false), replayTick(0), replayConsistent(true), simulationActive(false),
+      autopilotEnabled(false), headless(false), autopilotUsed(false){
+    leaderboard.open(leaderboardPath()); // 只启动后台线程，文件在其中加载，不阻塞启动
     selectedMap = EmptyMap; // Default map
 }
 
+SnakeGame::~SnakeGame() {
+    stopSimulation();
+}
+
 void SnakeGame::startGame() {
-    snake.reset();
-    score = 0;
-    gameOverFlag = false;
-    elapsedTime = 0;
+    stopSimulation();
+    paused = false;
+    tickStats = SimulationThread::TickStats();
+    inputStats = SimulationThread::InputStats();
+    // 每局开始时重新设定种子：指定过种子则复现该局，否则使用新的随机种子
+    core.reset(hasPendingSeed ? pendingSeed : Random::entropySeed(), selectedMap == ObstacleMap);
+    hasPendingSeed = false;
+    autopilotUsed = false;
+    replaying = replayPending;
+    replayPending = false;
+    replayTick = 0;
+    replayConsistent = true;
+    if (!replaying) {
+        replay.begin(core.getWidth(), core.getHeight(), selectedMap == ObstacleMap, difficulty, core.getSeed());
+    }
+    gameClock.reset();
     gameState = Playing;
-    obstacles.clear(); // 清空障碍物
-    
-    // 根据选择的地图类型生成障碍物
-    if (selectedMap == ObstacleMap) {
-        // 生成边界障碍物
-        for (int x = 0; x < GRID_WIDTH; ++x) {
-            obstacles.append(QPoint(x, 0));               // 上边界
-            obstacles.append(QPoint(x, GRID_HEIGHT - 1)); // 下边界
-        }
-        for (int y = 1; y < GRID_HEIGHT - 1; ++y) {
-            obstacles.append(QPoint(0, y));              // 左边界
-            obstacles.append(QPoint(GRID_WIDTH - 1, y)); // 右边界
-        }
-        
-        // 添加一些内部障碍物（数量适中）
-        int numObstacles = 15; // 例如15个内部障碍物
-        QList<QPoint> tempObstacles; // 临时存储新生成的障碍物
-        
-        for (int i = 0; i < numObstacles; ++i) {
-            int ox, oy;
-            bool validPosition = false;
-            int attempts = 0;
-            const int maxAttempts = 100; // 防止无限循环
-            
-            while (!validPosition && attempts < maxAttempts) {
-                attempts++;
-                // 确保障碍物不在边界（因为边界已经添加）和蛇起始位置
-                ox = 1 + rand() % (GRID_WIDTH - 2);
-                oy = 1 + rand() % (GRID_HEIGHT - 2);
-                
-                // 检查是否与现有障碍物冲突
-                validPosition = true;
-                
-                // 检查边界障碍物
-                if (obstacles.contains(QPoint(ox, oy))) {
-                    validPosition = false;
-                    continue;
-                }
-                
-                // 检查临时障碍物列表
-                if (tempObstacles.contains(QPoint(ox, oy))) {
-                    validPosition = false;
-                    continue;
-                }
-                
-                // 检查蛇的起始位置（中心）
-                if (ox == GRID_WIDTH / 2 && oy == GRID_HEIGHT / 2) {
-                    validPosition = false;
-                    continue;
-                }
-            }
-            
-            if (validPosition) {
-                tempObstacles.append(QPoint(ox, oy));
-            }
-        }
-        
-        // 将临时障碍物添加到主列表
-        obstacles.append(tempObstacles);
+    if (core.isGameOver()) {
+        endGame(); // 地图上没有任何空闲格子
+        return;
     }
-    
-    spawnFood();
     emit gameUpdated();
+    if (replaying) {
+        // 重放不需要等待玩家按键，直接按录像的难度开始推进
+        waitingForFirstMove = false;
+        startClock();
+        return;
+    }
     waitingForFirstMove = true;
-    elapsedTime = 0; 
     emit stopGameTimer();
+    autopilotMove(); // 自动驾驶不等待按键，第一步同样经 changeDirection() 启动游戏
 }
 
 void SnakeGame::restartGame() {
@@ -111,12 +61,26 @@ void SnakeGame::restartGame() {
     emit gameUpdated(); // Emit signal to trigger repaint in GameRenderer
 }
 
+void SnakeGame::setBoardSize(int width, int height) {
+    width = std::clamp(width, MIN_BOARD_SIZE, MAX_BOARD_SIZE);
+    height = std::clamp(height, MIN_BOARD_SIZE, MAX_BOARD_SIZE);
+    if (width == getBoardWidth() && height == getBoardHeight()) return;
+    stopSimulation();
+    core = GameCore(width, height);
+    gameState = Menu;
+    paused = false;
+    emit stopGameTimer();
+    emit boardSizeChanged();
+}
+
 void SnakeGame::setSelectedMap(MapType mapType) {
     selectedMap = mapType;
 }
 
 void SnakeGame::changeDirection(int key) {
     if (gameState != Playing) return; // Only allow direction changes in Playing state
+    if (replaying) return; // 重放时方向完全来自录像
+    if (paused) return;    // 暂停时忽略方向键，按 P / 空格继续
 
     // If waiting for the first move and a direction key is pressed
     if (waitingForFirstMove) {
@@ -145,15 +109,14 @@ void SnakeGame::changeDirection(int key) {
 
         if (isDirectionKey) {
             waitingForFirstMove = false;
-            elapsedTime = 0; 
-            emit startGameTimer(); // Start the game timer
-            snake.setDirection(initialDir);
+            core.setDirection(initialDir);
+            startClock(); // Start the game timer
             return; // Exit after handling the first move
         }
     }
 
     // Normal direction change logic
-    Snake::Direction dir = snake.getDirection();
+    Snake::Direction dir = getSnake().getDirection();
     switch (key) {
         case Qt::Key_Up:
             dir = Snake::Up;
@@ -170,27 +133,169 @@ void SnakeGame::changeDirection(int key) {
         default:
             return;
     }
-    snake.setDirection(dir);
+    // 模拟线程运行时方向连同按键时刻经无锁队列交给它，进入转向缓冲后每个逻辑帧采用一个
+    if (simulationActive) {
+        simulation.pushInput(dir);
+    } else {
+        core.setDirection(dir);
+    }
 }
 
 void SnakeGame::update() {
     if (gameState != Playing || waitingForFirstMove) return; // Don't update if waiting for first move
+    if (simulationActive) return; // 逻辑帧由模拟线程推进
+    autopilotMove();
+
+    if (replaying) {
+        if (replayTick >= replay.getTickCount()) {
+            endGame(); // 录像结束（例如录制时中途退出）
+            emit gameUpdated();
+            return;
+        }
+        core.setDirection(replay.inputAt(replayTick++));
+    } else {
+        // 记录本帧实际生效的方向（掉头等无效输入已被 Snake::setDirection() 过滤）
+        replay.record(core.getSnake().getDirection());
+    }
+    core.step();
+    if (core.isGameOver()) {
+        endGame();
+    }
+    emit gameUpdated();
+}
+
+int SnakeGame::advance() {
+    if (!simulationActive) return 0;
+    const quint64 before = simulation.frame().tickCount;
+    if (!simulation.poll()) return 0;
+    const SimulationThread::Frame& frame = simulation.frame();
+    autopilotUsed = autopilotUsed || frame.autopilotUsed;
+    tickStats = frame.stats;
+    inputStats = frame.input;
+    const int advanced = static_cast<int>(frame.tickCount - before);
+    if (frame.finished) {
+        // 游戏结束或录像放完：线程已退出，取回最终状态后在界面线程收尾
+        stopSimulation();
+        endGame();
+    }
+    emit gameUpdated();
+    return advanced;
+}
+
+int SnakeGame::getTickInterval() const {
+    switch (difficulty) {
+        case 1: return 150;
+        case 3: return 50;
+        default: return 100;
+    }
+}
+
+void SnakeGame::startClock() {
+    gameClock.start();
+    startSimulation();
+}
+
+void SnakeGame::startSimulation() {
+    if (headless) return; // 无界面模式由调用方 update() 推进
+    syncSimulationAutopilot();
+    simulation.start(core, replay, replaying, replayTick, static_cast<qint64>(getTickInterval()) * 1000000);
+    simulationActive = true;
+    emit startGameTimer();
+}
 
-    snake.move();
-    checkCollisions();
+void SnakeGame::pauseGame() {
+    if (gameState != Playing || waitingForFirstMove || paused) return;
+    stopSimulation();
+    gameClock.pause();
+    if (simulation.frame().finished) {
+        endGame(); // 暂停的同时模拟恰好结束
+        emit gameUpdated();
+        return;
+    }
+    paused = true;
+    emit stopGameTimer();
     emit gameUpdated();
 }
 
+void SnakeGame::resumeGame() {
+    if (!paused) return;
+    paused = false;
+    gameClock.resume();
+    startSimulation();
+    emit gameUpdated();
+}
+
+void SnakeGame::stopSimulation() {
+    if (!simulationActive) return;
+    simulation.stop();
+    simulation.poll(); // 取线程退出前发布的最后一帧
+    core = simulation.getCore();
+    replay = simulation.getReplay();
+    replayTick = simulation.getReplayTick();
+    autopilotUsed = autopilotUsed || simulation.frame().autopilotUsed;
+    tickStats = simulation.frame().stats;
+    inputStats = simulation.frame().input;
+    simulationActive = false;
+}
+
+void SnakeGame::setAutopilot(bool enabled) {
+    autopilotEnabled = enabled;
+    syncSimulationAutopilot();
+    if (waitingForFirstMove) {
+        autopilotMove();
+    }
+}
+
+void SnakeGame::setAutopilotStrategy(Autopilot::Strategy strategy) {
+    autopilot.setStrategy(strategy);
+    syncSimulationAutopilot();
+}
+
+bool SnakeGame::isAutopilotOnCycle() const {
+    if (simulationActive && simulation.frame().autopilotUsed) {
+        return simulation.frame().autopilotOnCycle;
+    }
+    return autopilot.isOnCycle();
+}
+
+void SnakeGame::syncSimulationAutopilot() {
+    simulation.setAutopilot(autopilotEnabled && !replaying, autopilot.getStrategy());
+}
+
+void SnakeGame::autopilotMove() {
+    // 模拟线程运行时由它在每个逻辑帧内决策，这里只处理第一步与同步推进的情形
+    if (!autopilotEnabled || gameState != Playing || replaying || paused || simulationActive) return;
+    const GameCore& current = getCore();
+    const Snake::Direction dir = autopilot.choose(current);
+    autopilotUsed = true;
+    // 方向不变时不必“按键”（除非在等待第一次按键，它负责启动游戏）
+    if (dir == current.getSnake().getDirection() && !waitingForFirstMove) return;
+    switch (dir) {
+        case Snake::Up:    changeDirection(Qt::Key_Up); break;
+        case Snake::Down:  changeDirection(Qt::Key_Down); break;
+        case Snake::Left:  changeDirection(Qt::Key_Left); break;
+        case Snake::Right: changeDirection(Qt::Key_Right); break;
+    }
+}
+
 int SnakeGame::getScore() const {
-    return score;
+    return simulationActive ? simulation.frame().score : core.getScore();
 }
 
 bool SnakeGame::isGameOver() const {
-    return gameOverFlag;
+    return simulationActive ? simulation.frame().gameOver : core.isGameOver();
+}
+
+bool SnakeGame::isBoardComplete() const {
+    return simulationActive ? simulation.frame().boardComplete : core.isBoardComplete();
 }
 
 const Food& SnakeGame::getFood() const {
-    return food;
+    return simulationActive ? simulation.frame().food : core.getFood();
+}
+
+quint64 SnakeGame::getTickCount() const {
+    return simulationActive ? simulation.frame().tickCount : core.getTickCount();
 }
 
 SnakeGame::GameState SnakeGame::getGameState() const {
@@ -198,11 +303,21 @@ SnakeGame::GameState SnakeGame::getGameState() const {
 }
 
 void SnakeGame::setGameState(GameState state) {
+    if (state != Playing) {
+        stopSimulation(); // 离开游戏（例如按 ESC 回到菜单）时停止模拟线程
+        gameClock.pause();
+        paused = false;
+        emit stopGameTimer(); // 菜单与结束界面没有移动的内容，显示帧定时器不必继续唤醒
+    }
     gameState = state;
 }
 
 void SnakeGame::setSnakeDirection(Snake::Direction dir) {
-    snake.setDirection(dir);
+    if (simulationActive) {
+        simulation.pushInput(dir);
+    } else {
+        core.setDirection(dir);
+    }
 }
 
 void SnakeGame::loadMap(int mapIndex) {
@@ -226,84 +341,91 @@ void SnakeGame::setDifficulty(int difficulty) {
 }
 
 int SnakeGame::getElapsedTime() const {
-    return elapsedTime;
+    return static_cast<int>(gameClock.elapsedMillis() / 1000);
 }
 
 int SnakeGame::getHighScore() const {
-    return highScore;
-}
-
-void SnakeGame::setElapsedTime(int time) {
-    this->elapsedTime = time;
+    return gameState == GameOver ? highScore : leaderboard.best(leaderboardKey());
 }
 
-void SnakeGame::checkCollisions() {
-    QPoint head = snake.getHead();
-    // Wall collision
-    if (head.x() < 0 || head.x() >= GRID_WIDTH || head.y() < 0 || head.y() >= GRID_HEIGHT) {
-        gameOverFlag = true;
-        gameState = GameOver;
-        if (score > highScore) {
-            highScore = score;
-            saveHighScore();
-        }
-        emit gameOver();
-        return;
-    }
-    // Self collision
-    if (snake.checkSelfCollision()) {
-        gameOverFlag = true;
-        gameState = GameOver;
-        if (score > highScore) {
-            highScore = score;
-            saveHighScore();
-        }
-        emit gameOver();
-        return;
-    }
-    // Obstacle collision
-    if (obstacles.contains(head)) {
-        gameOverFlag = true;
-        gameState = GameOver;
-        if (score > highScore) {
-            highScore = score;
-            saveHighScore();
-        }
-        emit gameOver();
-        return;
+void SnakeGame::endGame() {
+    gameState = GameOver;
+    gameClock.pause();
+    paused = false;
+    emit stopGameTimer();
+    if (!replaying && !headless) {
+        replay.setDurationMillis(gameClock.elapsedMillis());
+        replay.setFinalHash(core.getHash());
+        // 录像只在内存中交给后台线程，序列化与写盘都不在游戏结束的这一帧进行
+        replayWriter.save(lastReplayPath(), replay);
+    } else if (replaying && replay.hasFinalHash() && replayTick == replay.getTickCount()
+               && core.getHash() != replay.getFinalHash()) {
+        // 重放到最后一帧的状态与录制时不同：规则或随机数序列在两个版本之间发生了变化
+        qDebug() << "Replay desync: final state hash" << QString::number(core.getHash(), 16) << "expected"
+                 << QString::number(replay.getFinalHash(), 16);
+        replayConsistent = false;
+        emit replayDesync(core.getHash(), replay.getFinalHash());
     }
-    // Food collision
-    if (head == food.getPosition()) {
-        snake.grow();
-        score += 10;
-        spawnFood();
+    // 提交成绩只在内存中插入，写盘由排行榜的后台线程合并完成，游戏结束的这一帧不等待磁盘
+    const LeaderboardStore::Key key = leaderboardKey();
+    highScore = leaderboard.best(key);
+    leaderboardRank = 0;
+    if (!replaying && !autopilotUsed) {
+        LeaderboardStore::Entry entry;
+        entry.score = core.getScore();
+        entry.timeMillis = gameClock.elapsedMillis();
+        entry.seed = core.getSeed();
+        entry.date = QDateTime::currentMSecsSinceEpoch();
+        leaderboardRank = leaderboard.submit(key, entry);
     }
+    emit gameOver();
 }
 
-void SnakeGame::spawnFood() {
-    food.respawn(GRID_WIDTH, GRID_HEIGHT, snake.getBody(), obstacles);
+LeaderboardStore::Key SnakeGame::leaderboardKey() const {
+    return LeaderboardStore::Key{selectedMap, getBoardWidth(), getBoardHeight(), difficulty};
 }
 
-void SnakeGame::loadHighScore() {
-    QString filePath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/snake_highscore.txt";
-    QFile file(filePath);
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        highScore = in.readLine().toInt();
-        file.close();
-    }
+const QList<QPoint>& SnakeGame::getObstacles() const {
+    return getCore().getObstacles();
 }
 
-void SnakeGame::saveHighScore() {
-    QString filePath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/snake_highscore.txt";
-    QFile file(filePath);
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&file);
-        out << highScore;
-        file.close();
+void SnakeGame::setSeed(quint64 seed) {
+    pendingSeed = seed;
+    hasPendingSeed = true;
+}
+
+quint64 SnakeGame::getSeed() const {
+    return getCore().getSeed();
+}
+
+bool SnakeGame::saveReplay(const QString& path) const {
+    return ReplayWriter::writeFile(path, replay);
+}
+
+bool SnakeGame::loadReplay(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray bytes = file.readAll();
+    Replay loaded;
+    if (!loaded.deserialize(reinterpret_cast<const quint8*>(bytes.constData()), static_cast<size_t>(bytes.size()))) {
+        qDebug() << "Invalid replay file:" << path;
+        return false;
     }
+    replay = loaded;
+    setBoardSize(replay.getWidth(), replay.getHeight());
+    selectedMap = replay.isObstacleMap() ? ObstacleMap : EmptyMap;
+    difficulty = replay.getDifficulty();
+    setSeed(replay.getSeed());
+    replayPending = true;
+    return true;
 }
 
-const QList<QPoint>& SnakeGame::getObstacles() const {
-    return obstacles;
+QString SnakeGame::lastReplayPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/last_replay.snkr";
+}
+
+QString SnakeGame::leaderboardPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/leaderboard.txt";
 }
\ No newline at end of file
@@ -2,8 +2,17 @@
 #define SNAKEGAME_H
 
 #include <QObject>
+#include <QList>
+#include <QString>
 #include "Snake.h"
 #include "Food.h"
+#include "Autopilot.h"
+#include "GameClock.h"
+#include "GameCore.h"
+#include "LeaderboardStore.h"
+#include "Replay.h"
+#include "ReplayWriter.h"
+#include "SimulationThread.h"
 
 // 游戏状态枚举
 enum GameState {
@@ -18,7 +27,8 @@ enum MapType {
     ObstacleMap     // 有障碍物地图
 };
 
-// SnakeGame 类：游戏的主控制器，负责管理游戏状态、计时、分数、地图、蛇和食物等
+// SnakeGame 类：游戏的主控制器，负责管理游戏状态、计时、最高分与地图选择等
+// 具体的游戏规则（移动、碰撞、食物）由无界面的 GameCore 实现，SnakeGame 只是其上的 Qt 适配层
 class SnakeGame : public QObject {
     Q_OBJECT
 public:
@@ -38,6 +48,9 @@ enum MapType {
     // 构造函数
     explicit SnakeGame(QObject *parent = nullptr);
 
+    // 析构函数：停止模拟线程
+    ~SnakeGame() override;
+
     // 设置蛇的移动方向
     void setSnakeDirection(Snake::Direction dir);
 
@@ -50,24 +63,84 @@ enum MapType {
     // 重新开始游戏
     void restartGame();
 
+    // 暂停游戏：停止模拟线程与游戏时钟，局面保持不变（只在游戏进行中且已开始移动时有效）
+    void pauseGame();
+
+    // 从暂停处继续（未暂停时无操作）
+    void resumeGame();
+
+    // 是否处于暂停状态
+    bool isPaused() const { return paused; }
+
+    // 是否在等待玩家的第一次方向键（此时蛇不移动，游戏时钟也未启动）
+    bool isWaitingForFirstMove() const { return waitingForFirstMove; }
+
     // 根据按键改变方向
     void changeDirection(int key);
 
-    // 每帧更新游戏状态（定时器触发）
+    // 在当前线程同步推进一个逻辑帧（模拟线程运行时无效；自动驾驶时先由它选择方向）
     void update();
 
+    // 开关自动驾驶：每个逻辑帧由 Autopilot 选择方向。模拟线程运行时在模拟线程中对即将推进的那一帧决策，
+    // 否则（等待第一次按键、无界面模式）在当前线程决策并经 changeDirection() 交给游戏
+    // 自动驾驶操作过的对局不计入排行榜
+    void setAutopilot(bool enabled);
+
+    // 是否开启了自动驾驶
+    bool isAutopilot() const { return autopilotEnabled; }
+
+    // 设置 / 获取自动驾驶的策略（A* 寻路或哈密顿回路，回路构造不出时自动退回 A*）
+    void setAutopilotStrategy(Autopilot::Strategy strategy);
+    Autopilot::Strategy getAutopilotStrategy() const { return autopilot.getStrategy(); }
+
+    // 自动驾驶当前是否正沿哈密顿回路行走
+    bool isAutopilotOnCycle() const;
+
+    // 自动驾驶在当前线程中的决策统计（无界面模式；不含模拟线程中的决策）
+    const Autopilot::Stats& getAutopilotStats() const { return autopilot.getStats(); }
+
+    // 无界面模式：不启动模拟线程，由调用方反复 update() 以最快速度推进（批量跑自动驾驶对局），
+    // 结束时也不保存最近一局录像
+    void setHeadless(bool enabled) { headless = enabled; }
+
+    // 取模拟线程发布的最新快照（由渲染层按屏幕刷新率调用），返回快照前进的逻辑帧数
+    // 逻辑帧本身在模拟线程中按固定步长执行；模拟结束时在这里收尾（保存录像与最高分）
+    int advance();
+
+    // 当前时刻在快照帧与下一逻辑帧之间的位置 [0, 1]，渲染时据此插值
+    qreal getInterpolation() const { return simulationActive ? simulation.interpolation() : 0.0; }
+
+    // 每个逻辑帧的间隔（毫秒，由难度决定）
+    int getTickInterval() const;
+
+    // 本局迟到的逻辑帧数（执行时已晚于到期时间一个步长以上）与因积压过多被丢弃的帧数
+    quint64 getLateTicks() const { return tickStats.lateTicks; }
+    quint64 getDroppedTicks() const { return tickStats.droppedTicks; }
+
+    // 本局逻辑帧的定时统计（平均 / 最大抖动等）
+    const SimulationThread::TickStats& getTickStats() const { return tickStats; }
+
+    // 本局方向输入的统计（按键到蛇实际转向的延迟分布、被推迟 / 跳过 / 丢弃的输入数）
+    const SimulationThread::InputStats& getInputStats() const { return inputStats; }
+
     // 获取当前得分
     int getScore() const;
 
     // 判断游戏是否结束
     bool isGameOver() const;
 
-    // 获取蛇对象的常引用
-    const Snake& getSnake() const { return snake; }
+    // 判断是否因蛇填满整张地图而获胜结束
+    bool isBoardComplete() const;
+
+    // 获取蛇对象的常引用（模拟线程运行时为最新快照）
+    const Snake& getSnake() const { return simulationActive ? simulation.frame().snake : core.getSnake(); }
 
     // 获取食物对象的常引用
     const Food& getFood() const;
 
+    // 获取本局已推进的逻辑帧数
+    quint64 getTickCount() const;
+
     // 获取当前游戏状态
     GameState getGameState() const;
 
@@ -80,24 +153,68 @@ enum MapType {
     // 设置游戏难度
     void setDifficulty(int difficulty);
 
-    // 获取已用时间（秒）
+    // 获取本局用时（整秒，用于界面显示）
     int getElapsedTime() const;
 
-    // 设置已用时间
-    void setElapsedTime(int time);
-
-    // 设置最高分
-    void setHighScore(int score);
+    // 获取本局用时（毫秒，来自只在游戏进行中走动的游戏时钟）
+    qint64 getElapsedMillis() const { return gameClock.elapsedMillis(); }
 
-    // 获取最高分
+    // 获取当前地图与难度的最高分（游戏结束界面中为本局之前的纪录，用于判断是否破纪录）
     int getHighScore() const;
 
+    // 当前地图与难度的排行榜（按名次排列，最多 LeaderboardStore::TOP_K 条）
+    std::vector<LeaderboardStore::Entry> getLeaderboard() const { return leaderboard.entries(leaderboardKey()); }
+
+    // 最近一局在排行榜中的名次（从 1 开始，未上榜或重放时为 0）
+    int getLeaderboardRank() const { return leaderboardRank; }
+
     // 设置当前选中的地图类型
     void setSelectedMap(MapType mapType);
 
     // 获取障碍物位置列表
     const QList<QPoint>& getObstacles() const;
 
+    // 获取无界面游戏核心（只读）。模拟线程运行时只有地图尺寸、种子与障碍物是最新的（一局之中不变），
+    // 蛇、食物、得分与帧号停留在模拟线程启动时，应改用 getSnake()、getFood() 等访问器
+    const GameCore& getCore() const { return core; }
+
+    // 设置地图尺寸（宽高限制在 MIN_BOARD_SIZE..MAX_BOARD_SIZE，尺寸改变时重建游戏核心并回到菜单）
+    void setBoardSize(int width, int height);
+
+    // 获取地图宽度 / 高度（格子数）
+    int getBoardWidth() const { return getCore().getWidth(); }
+    int getBoardHeight() const { return getCore().getHeight(); }
+
+    static constexpr int DEFAULT_BOARD_SIZE = 20; // 默认地图边长
+    static constexpr int MIN_BOARD_SIZE = GameCore::MIN_SIZE; // 地图最小边长
+    static constexpr int MAX_BOARD_SIZE = GameCore::MAX_SIZE; // 地图最大边长
+
+    // 指定下一局游戏的随机种子（相同种子 + 相同操作 = 完全相同的对局）
+    void setSeed(quint64 seed);
+
+    // 获取当前对局使用的随机种子
+    quint64 getSeed() const;
+
+    // 获取当前（或最近一局）的录像
+    const Replay& getReplay() const { return replay; }
+
+    // 把当前录像保存到文件（同步写入）/ 从文件加载录像，失败时返回 false
+    // 加载成功后下一次 startGame() 将按录像自动重放（期间忽略方向键）
+    bool saveReplay(const QString& path) const;
+    bool loadReplay(const QString& path);
+
+    // 是否正在重放录像
+    bool isReplaying() const { return replaying; }
+
+    // 最近一局重放结束时的状态散列是否与录像记录的一致（没有重放过或录像没有记录散列时为 true）
+    bool isReplayConsistent() const { return replayConsistent; }
+
+    // 最近一局录像的默认保存路径
+    static QString lastReplayPath();
+
+    // 排行榜文件的默认路径
+    static QString leaderboardPath();
+
 signals:
     // 用于控制计时器：停止
     void stopGameTimer();
@@ -111,31 +228,61 @@ signals:
     // 游戏结束时触发
     void gameOver();
 
+    // 地图尺寸改变时触发（渲染层据此重新计算缩放与窗口大小）
+    void boardSizeChanged();
+
+    // 重放到录像最后一帧时状态散列与录制时不同（规则或随机数序列在两个版本之间发生了变化）
+    void replayDesync(quint64 actualHash, quint64 expectedHash);
+
 private:
-    // 加载最高分（从文件或配置）
-    void loadHighScore();
+    // 结束游戏：把成绩提交到排行榜（由后台线程写盘）并发出 gameOver 信号
+    void endGame();
+
+    // 当前地图类型、尺寸与难度对应的排行榜
+    LeaderboardStore::Key leaderboardKey() const;
+
+    // 启动游戏时钟与按当前难度运行的模拟线程，并通知渲染层开始按刷新率绘制
+    void startClock();
+
+    // 从 core 的当前状态启动模拟线程，并通知渲染层开始按刷新率绘制（开局与继续时共用）
+    void startSimulation();
 
-    // 保存最高分（到文件或配置）
-    void saveHighScore();
+    // 自动驾驶开启且模拟线程未运行时为当前局面选择方向，并像按键一样交给 changeDirection()
+    void autopilotMove();
 
-    // 检查碰撞（墙、自身、障碍）
-    void checkCollisions();
+    // 把自动驾驶的开关与策略同步给模拟线程（重放时保持关闭）
+    void syncSimulationAutopilot();
 
-    // 生成新食物
-    void spawnFood();
+    // 停止模拟线程并取回最终状态（未运行时无操作）
+    void stopSimulation();
 
     // 成员变量
-    Snake snake;               // 蛇对象
-    Food food;                 // 食物对象
-    int score;                 // 当前得分
-    bool gameOverFlag;         // 游戏结束标志
+    GameCore core;             // 无界面游戏核心（蛇、食物、障碍物、得分与随机数；模拟线程运行时暂停使用）
     GameState gameState;       // 当前游戏状态
     int difficulty;            // 游戏难度等级
-    int elapsedTime;           // 当前游戏用时（秒）
-    int highScore;             // 历史最高分
+    GameClock gameClock;       // 本局游戏时钟（首次按键或开始重放时启动，离开游戏进行状态时暂停）
+    int highScore;             // 最近一局结束时之前的最高分（游戏结束界面据此判断是否破纪录）
+    int leaderboardRank;       // 最近一局在排行榜中的名次（未上榜为 0）
+    LeaderboardStore leaderboard; // 按地图与难度分榜的排行榜（后台线程加载与写盘）
     MapType selectedMap;       // 当前选中的地图类型
-    QList<QPoint> obstacles;   // 障碍物位置列表
+    quint64 pendingSeed;       // 通过 setSeed() 指定的下一局种子
+    bool hasPendingSeed;       // 是否指定了下一局种子（否则每局从系统熵源取新种子）
     bool waitingForFirstMove; // 等待玩家首次操作的标志（避免游戏一开始自动移动）
+    bool paused;               // 是否暂停（游戏进行中，模拟线程与游戏时钟都已停止）
+    Replay replay;             // 当前对局的录像（正常游戏时录制，重放时作为输入来源）
+    ReplayWriter replayWriter; // 在后台线程中把最近一局录像写到 lastReplayPath()
+    bool replayPending;        // 已加载录像，等待下一次 startGame() 开始重放
+    bool replaying;            // 当前对局是否在重放录像
+    int replayTick;            // 重放进度（下一帧的帧号）
+    bool replayConsistent;     // 最近一局重放的结束状态与录像一致
+    SimulationThread simulation; // 模拟线程（游戏进行中推进 core 的副本）
+    bool simulationActive;     // 模拟线程是否持有本局状态（此时 core 不是最新的）
+    Autopilot autopilot;       // 自动驾驶（搜索缓冲区随地图尺寸预先分配）
+    bool autopilotEnabled;     // 是否开启自动驾驶
+    bool headless;             // 无界面模式（同步推进，不启动模拟线程）
+    bool autopilotUsed;        // 本局是否由自动驾驶操作过（这样的对局不计入排行榜）
+    SimulationThread::TickStats tickStats; // 本局逻辑帧的定时统计
+    SimulationThread::InputStats inputStats; // 本局方向输入的统计
 };
 
 #endif // SNAKEGAME_H
@@ -1,13 +1,53 @@
-QT += widgets multimedia
+QT += widgets multimedia opengl openglwidgets
 CONFIG += c++20
 TARGET = SnakeGameQt
 TEMPLATE = app
 SOURCES += main.cpp \
     Snake.cpp \
     SnakeGame.cpp \
+    GameCore.cpp \
     Food.cpp \
-    GameRenderer.cpp
+    OccupancyGrid.cpp \
+    FreeCellSet.cpp \
+    Random.cpp \
+    BoardEngine.cpp \
+    Autopilot.cpp \
+    HamiltonCycle.cpp \
+    Replay.cpp \
+    ReplayWriter.cpp \
+    FixedTimestep.cpp \
+    GameClock.cpp \
+    LatencyHistogram.cpp \
+    LeaderboardStore.cpp \
+    SimulationThread.cpp \
+    GameRenderer.cpp \
+    SpriteAtlas.cpp \
+    AnimationScheduler.cpp \
+    InstancedBoardRenderer.cpp \
+    GLBoardWidget.cpp
 HEADERS += Snake.h \
+    Zobrist.h \
     SnakeGame.h \
+    GameCore.h \
     Food.h \
-    GameRenderer.h
\ No newline at end of file
+    OccupancyGrid.h \
+    FreeCellSet.h \
+    Random.h \
+    BitBoard.h \
+    BoardEngine.h \
+    Autopilot.h \
+    HamiltonCycle.h \
+    Replay.h \
+    ReplayWriter.h \
+    FixedTimestep.h \
+    GameClock.h \
+    TripleBuffer.h \
+    LatencyHistogram.h \
+    LeaderboardStore.h \
+    SpscQueue.h \
+    SimulationThread.h \
+    GameRenderer.h \
+    SpriteAtlas.h \
+    AnimationScheduler.h \
+    InstancedBoardRenderer.h \
+    GLBoardWidget.h
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include "SpriteAtlas.h"
+#include <algorithm>
+#include <cmath>
+
+SpriteAtlas::SpriteAtlas()
+    : spriteCount(0), columns(1), logicalSize(1), pixels(1) {}
+
+void SpriteAtlas::reset(int count, int spriteSize, int pixelSize) {
+    spriteCount = count;
+    logicalSize = spriteSize;
+    pixels = std::max(1, pixelSize);
+    // 排成接近正方形的网格，避免图集过宽超出纹理尺寸限制
+    columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    const int rows = (count + columns - 1) / columns;
+    atlas = QPixmap(columns * pixels, rows * pixels);
+    atlas.fill(Qt::transparent);
+}
+
+void SpriteAtlas::clear() {
+    atlas = QPixmap();
+    spriteCount = 0;
+}
+
+QPainter::PixmapFragment SpriteAtlas::fragment(int index, const QPointF& center, qreal size) const {
+    const QRect source = sourceRect(index);
+    const qreal scale = size / pixels;
+    return QPainter::PixmapFragment::create(center, QRectF(source), scale, scale);
+}
+
+void SpriteAtlas::drawFragments(QPainter& painter, const QVector<QPainter::PixmapFragment>& fragments) const {
+    if (fragments.isEmpty()) return;
+    painter.drawPixmapFragments(fragments.constData(), fragments.size(), atlas);
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <QPainter>
+#include <QPixmap>
+#include <QRect>
+#include <QVector>
+
+// SpriteAtlas 类：纹理图集，把若干同尺寸的小图（精灵）预先渲染进一张大图
+// 绘制时只需从图集中复制对应区域（drawPixmap / drawPixmapFragments），不再逐帧构造渐变和矢量路径
+// 图集按设备像素比放大，高分屏上保持清晰
+class SpriteAtlas {
+public:
+    // 构造函数：创建空图集
+    SpriteAtlas();
+
+    // 重新分配图集：count 个精灵，每个边长 spriteSize 逻辑单位，渲染到 pixelSize x pixelSize 个设备像素
+    void reset(int count, int spriteSize, int pixelSize);
+
+    // 释放图集（下次使用前需要重新 reset 并渲染）
+    void clear();
+
+    // 图集是否为空
+    bool isNull() const { return atlas.isNull(); }
+
+    // 精灵数量与逻辑边长
+    int count() const { return spriteCount; }
+    int spriteSize() const { return logicalSize; }
+
+    // 在第 index 个精灵的位置上绘制：painter 已平移、缩放到精灵的逻辑坐标 (0, 0) - (spriteSize, spriteSize)
+    template <typename Fn>
+    void render(int index, Fn&& paint) {
+        QPainter painter(&atlas);
+        painter.setRenderHint(QPainter::Antialiasing);
+        const QRect source = sourceRect(index);
+        painter.setClipRect(source);
+        painter.translate(source.topLeft());
+        painter.scale(qreal(pixels) / logicalSize, qreal(pixels) / logicalSize);
+        paint(painter);
+    }
+
+    // 把第 index 个精灵绘制到 target（painter 当前坐标系中的矩形）
+    void draw(QPainter& painter, int index, const QRectF& target) const {
+        painter.drawPixmap(target, atlas, QRectF(sourceRect(index)));
+    }
+
+    // 生成一个批量绘制片段：精灵中心位于 center，边长为 size（painter 当前坐标系）
+    QPainter::PixmapFragment fragment(int index, const QPointF& center, qreal size) const;
+
+    // 一次调用绘制一批片段
+    void drawFragments(QPainter& painter, const QVector<QPainter::PixmapFragment>& fragments) const;
+
+private:
+    // 第 index 个精灵在图集中的设备像素区域
+    QRect sourceRect(int index) const {
+        return QRect((index % columns) * pixels, (index / columns) * pixels, pixels, pixels);
+    }
+
+    QPixmap atlas;     // 图集（未设置设备像素比，坐标即设备像素）
+    int spriteCount;   // 精灵数量
+    int columns;       // 每行精灵数
+    int logicalSize;   // 精灵逻辑边长
+    int pixels;        // 精灵设备像素边长
+};
+
+#endif // SPRITEATLAS_H
\ No newline at end of file
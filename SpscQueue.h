@@ -0,0 +1,46 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// SpscQueue 类模板：单生产者 / 单消费者的无锁环形队列，容量为 N - 1
+// 生产者只写 tail，消费者只写 head，各自用 acquire / release 看到对方的进度，不需要互斥锁
+template <typename T, size_t N>
+class SpscQueue {
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // 生产者：入队，队列已满时返回 false
+    bool push(const T& value) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        const size_t next = (t + 1) % N;
+        if (next == head.load(std::memory_order_acquire)) return false;
+        items[t] = value;
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者：出队，队列为空时返回 false
+    bool pop(T& value) {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        value = items[h];
+        head.store((h + 1) % N, std::memory_order_release);
+        return true;
+    }
+
+    // 清空队列（只能在没有并发访问时调用）
+    void clear() {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::array<T, N> items;
+    alignas(64) std::atomic<size_t> head; // 下一个要读取的位置（消费者写；与 tail 分属不同缓存行）
+    alignas(64) std::atomic<size_t> tail; // 下一个要写入的位置（生产者写）
+};
+
+#endif // SPSCQUEUE_H
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(int bits)
+    : used(0), mask(0) {
+    if (bits > 0) resize(bits);
+}
+
+void TranspositionTable::resize(int bits) {
+    const quint64 slots = quint64(1) << bits;
+    entries.reset(new Entry[slots]);
+    usedSlots.reset(new quint64[slots]);
+    used.store(0, std::memory_order_relaxed);
+    mask = slots - 1;
+}
+
+quint64 TranspositionTable::find(quint64 key) const {
+    if (!entries) return 0;
+    key = normalize(key);
+    for (int probe = 0; probe < MAX_PROBES; ++probe) {
+        const Entry& entry = entries[(key + probe) & mask];
+        const quint64 stored = entry.key.load(std::memory_order_acquire);
+        if (stored == key) return entry.value.load(std::memory_order_acquire);
+        if (stored == 0) return 0;
+    }
+    return 0;
+}
+
+quint64 TranspositionTable::insert(quint64 key, quint64 value) {
+    if (!entries) return 0;
+    key = normalize(key);
+    for (int probe = 0; probe < MAX_PROBES; ++probe) {
+        const quint64 slot = (key + probe) & mask;
+        Entry& entry = entries[slot];
+        quint64 stored = entry.key.load(std::memory_order_acquire);
+        if (stored == 0) {
+            if (entry.key.compare_exchange_strong(stored, key, std::memory_order_acq_rel)) {
+                entry.value.store(value, std::memory_order_release);
+                usedSlots[used.fetch_add(1, std::memory_order_relaxed)] = slot;
+                return value;
+            }
+            // CAS 失败时 stored 为抢先占据槽位的键，按下面的规则继续
+        }
+        if (stored == key) return entry.value.load(std::memory_order_acquire);
+    }
+    return 0;
+}
+
+void TranspositionTable::clear() {
+    const quint64 count = used.load(std::memory_order_relaxed);
+    for (quint64 i = 0; i < count; ++i) {
+        Entry& entry = entries[usedSlots[i]];
+        entry.key.store(0, std::memory_order_relaxed);
+        entry.value.store(0, std::memory_order_relaxed);
+    }
+    used.store(0, std::memory_order_relaxed);
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+// TranspositionTable 类：以状态散列（见 Zobrist）为键、64 位整数为值的无锁置换表，供多个搜索线程并发查找与插入
+// 开放寻址、线性探测，每个槽位是两个原子量（键与值，值为 0 表示尚未发布）：插入先用 CAS 占据键为 0 的槽位，
+// 再发布值；其他线程看到键相同但值尚未发布时按未命中处理、不等待，因此任何线程都不会被阻塞
+// 表不扩容，探测 MAX_PROBES 个槽位都被其他键占据时放弃插入；clear() 只清掉上次清空以来用过的槽位
+class TranspositionTable {
+public:
+    static constexpr int MAX_PROBES = 8; // 每次查找 / 插入最多探测的槽位数
+
+    // 构造函数：2^bits 个槽位（bits 为 0 时不分配，之后用 resize() 分配）
+    explicit TranspositionTable(int bits = 0);
+
+    // 重新分配为 2^bits 个槽位并清空（不能与查找 / 插入并发）
+    void resize(int bits);
+
+    // 槽位数
+    quint64 capacity() const { return mask + 1; }
+
+    // 已占用的槽位数
+    quint64 size() const { return used.load(std::memory_order_relaxed); }
+
+    // 查找 key 对应的值，没有（或另一个线程尚未发布）时返回 0
+    quint64 find(quint64 key) const;
+
+    // 插入 key -> value（value 不为 0）：key 已有值时返回已有的值，插入成功时返回 value，
+    // 表中没有位置或另一个线程正在插入同一个键时返回 0
+    quint64 insert(quint64 key, quint64 value);
+
+    // 清空（不能与查找 / 插入并发），耗时与占用的槽位数成正比
+    void clear();
+
+private:
+    struct Entry {
+        std::atomic<quint64> key{0};
+        std::atomic<quint64> value{0};
+    };
+
+    // 键 0 表示空槽位，散列恰好为 0 的状态改用键 1
+    static quint64 normalize(quint64 key) { return key ? key : 1; }
+
+    std::unique_ptr<Entry[]> entries;
+    std::unique_ptr<quint64[]> usedSlots; // 已占用槽位的下标（clear() 据此清零）
+    std::atomic<quint64> used;
+    quint64 mask;
+};
+
+#endif // TRANSPOSITIONTABLE_H
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// TripleBuffer 类模板：单写者 / 单读者的无锁三缓冲
+// 写者始终独占“后台”缓冲区，写完后 publish() 与“中间”缓冲区原子交换；
+// 读者 acquire() 时若中间缓冲区有新数据，再把它与“前台”缓冲区原子交换
+// 双方都不会等待对方，读者拿到的总是最近一次发布的完整快照（中间被覆盖的旧快照直接丢弃）
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : middle(MIDDLE), back(BACK), front(FRONT) {}
+
+    // 把三个缓冲区都设为 value（只能在没有并发读写时调用，例如启动写者线程之前）
+    void reset(const T& value) {
+        for (T& buffer : buffers) buffer = value;
+        middle.store(MIDDLE, std::memory_order_relaxed);
+        back = BACK;
+        front = FRONT;
+    }
+
+    // 写者：当前可写的后台缓冲区
+    T& writeBuffer() { return buffers[back]; }
+
+    // 写者：发布后台缓冲区的内容，换到一个空闲缓冲区继续写
+    void publish() {
+        back = middle.exchange(back | NEW_DATA, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // 读者：有新发布的数据时换到前台并返回 true
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & NEW_DATA)) return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // 读者：当前前台缓冲区（在下一次 acquire() 之前保持不变）
+    const T& readBuffer() const { return buffers[front]; }
+
+private:
+    static constexpr int FRONT = 0;
+    static constexpr int MIDDLE = 1;
+    static constexpr int BACK = 2;
+    static constexpr int INDEX_MASK = 3;
+    static constexpr int NEW_DATA = 4; // 中间缓冲区含有读者尚未取走的数据
+
+    T buffers[3];
+    std::atomic<int> middle; // 中间缓冲区下标（附带 NEW_DATA 标志）
+    int back;                // 写者独占
+    int front;               // 读者独占
+};
+
+#endif // TRIPLEBUFFER_H
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : slots(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())),
+      body(nullptr), grain(1), generation(0), running(0), stopping(false) {
+    for (int i = 1; i < size(); ++i) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::parallelFor(quint64 count, quint64 taskGrain, const Body& taskBody) {
+    count = std::min(count, MAX_TASKS);
+    // 任务按线程数均分为初始区间，之后由偷取自动平衡
+    const quint64 workers = static_cast<quint64>(size());
+    for (quint64 i = 0; i < workers; ++i) {
+        slots[i].range.store(pack(count * i / workers, count * (i + 1) / workers), std::memory_order_relaxed);
+        slots[i].steals = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        body = &taskBody;
+        grain = std::max<quint64>(1, taskGrain);
+        running = size() - 1;
+        ++generation;
+    }
+    wake.notify_all();
+    work(0);
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return running == 0; });
+    body = nullptr;
+}
+
+quint64 WorkStealingPool::getSteals() const {
+    quint64 total = 0;
+    for (const Slot& slot : slots) {
+        total += slot.steals;
+    }
+    return total;
+}
+
+void WorkStealingPool::workerLoop(int worker) {
+    quint64 seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        work(worker);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --running;
+        }
+        done.notify_one();
+    }
+}
+
+void WorkStealingPool::work(int worker) {
+    quint64 begin;
+    quint64 end;
+    for (;;) {
+        while (take(worker, begin, end)) {
+            (*body)(worker, begin, end);
+        }
+        if (!steal(worker)) return;
+    }
+}
+
+bool WorkStealingPool::take(int worker, quint64& begin, quint64& end) {
+    std::atomic<quint64>& range = slots[worker].range;
+    quint64 current = range.load(std::memory_order_acquire);
+    for (;;) {
+        begin = beginOf(current);
+        const quint64 last = endOf(current);
+        if (begin >= last) return false;
+        end = std::min(begin + grain, last);
+        if (range.compare_exchange_weak(current, pack(end, last), std::memory_order_acq_rel)) return true;
+    }
+}
+
+bool WorkStealingPool::steal(int worker) {
+    // 从下一个线程开始轮流查看，偷走第一个非空区间的后一半（不足两块时整段偷走）
+    for (int offset = 1; offset < size(); ++offset) {
+        std::atomic<quint64>& victim = slots[(worker + offset) % size()].range;
+        quint64 current = victim.load(std::memory_order_acquire);
+        for (;;) {
+            const quint64 begin = beginOf(current);
+            const quint64 end = endOf(current);
+            if (begin >= end) break;
+            const quint64 remaining = end - begin;
+            const quint64 split = remaining >= 2 * grain ? end - remaining / 2 : begin;
+            if (victim.compare_exchange_weak(current, pack(begin, split), std::memory_order_acq_rel)) {
+                // 自己的区间此时为空，其他线程对它的 CAS 都会因值改变而失败
+                slots[worker].range.store(pack(split, end), std::memory_order_release);
+                ++slots[worker].steals;
+                return true;
+            }
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// WorkStealingPool 类：固定数量的工作线程，并行执行 [0, count) 上的独立任务（例如批量对局）
+// 每个线程持有一段连续的任务区间，打包为一个 64 位原子量（低 32 位 begin，高 32 位 end）：
+//   线程自己从 begin 端按 grain 个一块取任务，空闲的线程从别人的 end 端偷走剩余任务的一半，
+//   两者都只对这一个原子量做 CAS，没有全局锁；任务在线程间只会移动、不会新增，所有区间都空即全部完成
+// 调用 parallelFor() 的线程也作为 0 号工作线程参与执行
+class WorkStealingPool {
+public:
+    // 任务体：worker 为执行它的线程编号（0..size()-1），[begin, end) 为一块任务
+    using Body = std::function<void(int worker, quint64 begin, quint64 end)>;
+
+    static constexpr quint64 MAX_TASKS = 0xFFFFFFFFull; // 单次 parallelFor() 的最大任务数
+
+    // 构造函数：启动 threads - 1 个后台线程（threads <= 0 时使用硬件线程数）
+    explicit WorkStealingPool(int threads = 0);
+
+    // 析构函数：通知后台线程退出并等待
+    ~WorkStealingPool();
+
+    // 工作线程数（含调用线程）
+    int size() const { return static_cast<int>(slots.size()); }
+
+    // 并行执行 [0, count) 的任务，阻塞到全部完成（count 不超过 MAX_TASKS）
+    void parallelFor(quint64 count, quint64 grain, const Body& body);
+
+    // 上一次 parallelFor() 中成功偷取的次数
+    quint64 getSteals() const;
+
+private:
+    // 每个线程的任务区间，独占一条缓存行，避免线程间的伪共享
+    struct alignas(64) Slot {
+        std::atomic<quint64> range{0};
+        quint64 steals = 0;
+    };
+
+    static quint64 pack(quint64 begin, quint64 end) { return begin | (end << 32); }
+    static quint64 beginOf(quint64 range) { return range & 0xFFFFFFFFull; }
+    static quint64 endOf(quint64 range) { return range >> 32; }
+
+    // 后台线程主循环：等待新一轮任务，执行完后报告完成
+    void workerLoop(int worker);
+
+    // 执行任务直到所有区间都空
+    void work(int worker);
+
+    // 从自己的区间取一块任务
+    bool take(int worker, quint64& begin, quint64& end);
+
+    // 从其他线程的区间偷取一半任务放入自己的区间
+    bool steal(int worker);
+
+    std::vector<Slot> slots;
+    std::vector<std::thread> threads;
+    const Body* body;            // 本轮任务体（只在 parallelFor() 期间有效）
+    quint64 grain;               // 本轮每块的任务数
+
+    // 只用于开始 / 结束一轮任务的同步，执行任务期间不加锁
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    quint64 generation;          // 第几轮任务（后台线程据此发现新任务）
+    int running;                 // 本轮仍在执行的后台线程数
+    bool stopping;
+};
+
+#endif // WORKSTEALINGPOOL_H
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <QtGlobal>
+
+// Zobrist 类：游戏状态 64 位散列使用的随机键
+// 状态散列为以下键的异或：每个蛇身格子、蛇头格子、蛇尾格子、食物格子、移动方向、“下一步增长”标志；
+// Snake、Food 与 RolloutState 在状态变化时异或进 / 出对应的键，每步 O(1) 增量维护
+// 键不查表，而是把（种类, 格子编号）经 splitmix64 混合得到：4096x4096 的地图上每类键一张表就要 128 MB，
+// 混合只需几次乘法与移位，且在所有平台上结果相同（录像与联机校验依赖这一点）
+class Zobrist {
+public:
+    static quint64 body(quint32 cell) { return mix((quint64(cell) << 2) | 0); }
+    static quint64 head(quint32 cell) { return mix((quint64(cell) << 2) | 1); }
+    static quint64 tail(quint32 cell) { return mix((quint64(cell) << 2) | 2); }
+    static quint64 food(quint32 cell) { return mix((quint64(cell) << 2) | 3); }
+
+    // 方向（Snake::Direction 的取值）与增长标志
+    static quint64 direction(int dir) { return mix(DIRECTION_BASE + quint64(dir)); }
+    static quint64 growing() { return mix(GROWING_KEY); }
+
+private:
+    // 格子键的输入最多 2^26，方向与增长标志的输入取在其上方，互不重叠
+    static constexpr quint64 DIRECTION_BASE = quint64(1) << 40;
+    static constexpr quint64 GROWING_KEY = quint64(1) << 41;
+
+    // splitmix64 的混合步骤（加上固定的盐，使格子 0 的键不为 0）
+    static quint64 mix(quint64 x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+};
+
+#endif // ZOBRIST_H
\ No newline at end of file
@@ -0,0 +1,102 @@
+// BatchBenchmark：比较 BatchEnv 批量推进与 N 个独立 GameCore 的速度，并逐帧校验两者结果完全一致
+// 用法：SnakeBatchBenchmark [对局数 N] [帧数] [地图: 0=无障碍, 1=障碍物]
+#include "BatchEnv.h"
+#include "GameCore.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+// 生成每一帧的动作：大部分时间保持方向，偶尔随机转向
+void fillActions(Random& rng, std::vector<qint8>& actions) {
+    for (qint8& action : actions) {
+        const int roll = rng.bounded(8);
+        action = roll < 4 ? static_cast<qint8>(roll) : qint8(-1);
+    }
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int games = argc > 1 ? std::atoi(argv[1]) : 4096;
+    const int steps = argc > 2 ? std::atoi(argv[2]) : 2000;
+    const bool obstacleMap = argc > 3 && std::atoi(argv[3]) != 0;
+    const quint64 baseSeed = 2025;
+
+    // 预先生成全部动作，两种实现使用相同的输入
+    Random actionRng(7);
+    std::vector<std::vector<qint8>> actions(steps, std::vector<qint8>(games));
+    for (auto& frame : actions) {
+        fillActions(actionRng, frame);
+    }
+
+    // 批量推进
+    BatchEnv batch(games, 20, 20, obstacleMap, baseSeed);
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < steps; ++t) {
+        batch.step(actions[t].data());
+    }
+    const double batchSeconds = secondsSince(start);
+
+    // N 个独立的 GameCore
+    std::vector<GameCore> cores(games, GameCore(20, 20));
+    std::vector<quint64> episodes(games, 0);
+    for (int i = 0; i < games; ++i) {
+        cores[i].reset(BatchEnv::seedFor(baseSeed, i, 0), obstacleMap);
+    }
+    start = std::chrono::steady_clock::now();
+    for (int t = 0; t < steps; ++t) {
+        for (int i = 0; i < games; ++i) {
+            const qint8 action = actions[t][i];
+            GameCore::StepResult result = action < 0
+                ? cores[i].step() : cores[i].step(static_cast<Snake::Direction>(action));
+            if (result != GameCore::Moved && result != GameCore::AteFood) {
+                cores[i].reset(BatchEnv::seedFor(baseSeed, i, ++episodes[i]), obstacleMap);
+            }
+        }
+    }
+    const double coreSeconds = secondsSince(start);
+
+    // 重新运行一遍，逐帧校验
+    BatchEnv check(games, 20, 20, obstacleMap, baseSeed);
+    for (int i = 0; i < games; ++i) {
+        episodes[i] = 0;
+        cores[i].reset(BatchEnv::seedFor(baseSeed, i, 0), obstacleMap);
+    }
+    long long mismatches = 0;
+    for (int t = 0; t < steps; ++t) {
+        check.step(actions[t].data());
+        for (int i = 0; i < games; ++i) {
+            const qint8 action = actions[t][i];
+            GameCore& core = cores[i];
+            GameCore::StepResult result = action < 0
+                ? core.step() : core.step(static_cast<Snake::Direction>(action));
+            bool same = check.results()[i] == result;
+            if (result != GameCore::Moved && result != GameCore::AteFood) {
+                same = same && check.finalScore(i) == core.getScore();
+                core.reset(BatchEnv::seedFor(baseSeed, i, ++episodes[i]), obstacleMap);
+            }
+            same = same && check.head(i) == core.getSnake().getHead()
+                && check.direction(i) == core.getSnake().getDirection()
+                && check.length(i) == core.getSnake().getLength()
+                && check.score(i) == core.getScore()
+                && check.food(i) == core.getFood().getPosition();
+            if (!same && mismatches++ < 10) {
+                std::printf("mismatch: game %d at step %d\n", i, t);
+            }
+        }
+    }
+
+    const double total = double(games) * steps;
+    std::printf("games x steps:          %d x %d\n", games, steps);
+    std::printf("BatchEnv steps/second:  %.0f\n", total / batchSeconds);
+    std::printf("GameCore steps/second:  %.0f\n", total / coreSeconds);
+    std::printf("mismatches:             %lld\n", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
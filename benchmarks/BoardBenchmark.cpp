@@ -0,0 +1,67 @@
+// BoardBenchmark：比较编译期特化的 Board<20, 20> 与运行时 GenericBoard 的洪水填充速度（同时检查结果一致）
+// 用法：SnakeBoardBenchmark [填充次数] [障碍物比例(百分比)]
+#include "BitBoard.h"
+#include "Random.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const int WIDTH = 20;
+const int HEIGHT = 20;
+
+// 预先生成的随机地图：被占用的格子列表与填充起点
+struct Layout {
+    std::vector<int> blocked;
+    int start;
+};
+
+// 对所有地图各做一次洪水填充，返回可达格子数之和
+template <typename B>
+long long fillAll(const std::vector<Layout>& layouts, B passable, long long fills, double* seconds) {
+    B reach = passable;
+    long long total = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (long long i = 0; i < fills; ++i) {
+        const Layout& layout = layouts[i % layouts.size()];
+        passable.fill();
+        for (int cell : layout.blocked) passable.reset(cell);
+        reach.clear();
+        reach.set(layout.start);
+        reach.floodFill(passable);
+        total += reach.count();
+    }
+    *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return total;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const long long fills = argc > 1 ? std::atoll(argv[1]) : 1000000LL;
+    const int density = argc > 2 ? std::atoi(argv[2]) : 25;
+
+    Random rng(1);
+    std::vector<Layout> layouts(1024);
+    for (Layout& layout : layouts) {
+        for (int cell = 0; cell < WIDTH * HEIGHT; ++cell) {
+            if (rng.bounded(100) < density) layout.blocked.push_back(cell);
+        }
+        layout.start = rng.bounded(WIDTH * HEIGHT);
+    }
+
+    double specializedSeconds = 0;
+    double genericSeconds = 0;
+    const long long specialized = fillAll(layouts, Board<WIDTH, HEIGHT>(), fills, &specializedSeconds);
+    const long long generic = fillAll(layouts, GenericBoard(WIDTH, HEIGHT), fills, &genericSeconds);
+
+    std::printf("board:                  %dx%d, %d%% blocked\n", WIDTH, HEIGHT, density);
+    std::printf("fills:                  %lld\n", fills);
+    std::printf("Board<%d,%d> fills/s:   %.0f\n", WIDTH, HEIGHT, fills / specializedSeconds);
+    std::printf("GenericBoard fills/s:   %.0f\n", fills / genericSeconds);
+    std::printf("speedup:                %.2fx\n", genericSeconds / specializedSeconds);
+    std::printf("results match:          %s\n", specialized == generic ? "yes" : "NO");
+    return specialized == generic ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+// CoreBenchmark：测量无界面 GameCore 在单核上的推进速度（每秒逻辑帧数）
+// 用法：SnakeCoreBenchmark [总帧数] [地图: 0=无障碍, 1=障碍物]
+#include "GameCore.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+// 判断两个方向是否相反（蛇不能直接掉头）
+bool isReverse(Snake::Direction a, Snake::Direction b) {
+    return (a == Snake::Up && b == Snake::Down) || (a == Snake::Down && b == Snake::Up)
+        || (a == Snake::Left && b == Snake::Right) || (a == Snake::Right && b == Snake::Left);
+}
+
+// 简单的策略：优先朝食物方向走，避开会立即死亡的格子
+Snake::Direction choose(const GameCore& core) {
+    const Snake& snake = core.getSnake();
+    const QPoint head = snake.getHead();
+    const QPoint food = core.getFood().getPosition();
+    const Snake::Direction order[4] = {
+        food.x() > head.x() ? Snake::Right : Snake::Left,
+        food.y() > head.y() ? Snake::Down : Snake::Up,
+        food.x() > head.x() ? Snake::Left : Snake::Right,
+        food.y() > head.y() ? Snake::Up : Snake::Down,
+    };
+    for (Snake::Direction dir : order) {
+        if (isReverse(dir, snake.getDirection())) continue;
+        QPoint next = head;
+        switch (dir) {
+            case Snake::Up:    next.ry() -= 1; break;
+            case Snake::Down:  next.ry() += 1; break;
+            case Snake::Left:  next.rx() -= 1; break;
+            case Snake::Right: next.rx() += 1; break;
+        }
+        if (snake.getOccupancy().contains(next) && !snake.isOccupied(next)
+            && core.getFreeCells().contains(next)) {
+            return dir;
+        }
+    }
+    return snake.getDirection();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const long long totalSteps = argc > 1 ? std::atoll(argv[1]) : 20000000LL;
+    const bool obstacleMap = argc > 2 && std::atoi(argv[2]) != 0;
+
+    GameCore core;
+    quint64 seed = 1;
+    core.reset(seed, obstacleMap);
+
+    long long games = 1;
+    long long totalScore = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < totalSteps; ++i) {
+        core.step(choose(core));
+        if (core.isGameOver()) {
+            totalScore += core.getScore();
+            core.reset(++seed, obstacleMap);
+            ++games;
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::printf("steps:          %lld\n", totalSteps);
+    std::printf("games:          %lld\n", games);
+    std::printf("average score:  %.1f\n", games > 1 ? double(totalScore) / (games - 1) : 0.0);
+    std::printf("elapsed:        %.3f s\n", seconds);
+    std::printf("steps/second:   %.0f\n", totalSteps / seconds);
+    return 0;
+}
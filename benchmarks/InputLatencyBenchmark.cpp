@@ -0,0 +1,82 @@
+// InputLatencyBenchmark：测量按键到蛇实际转向的延迟（难度 3，即 50 ms 一个逻辑帧）
+// 用法：SnakeInputLatencyBenchmark [逻辑帧步长(ms)] [运行秒数] [连按比例(%)]
+// 主线程模拟玩家：每隔 20 ~ 120 ms 随机按下上 / 下 / 右之一，其中一部分按键紧跟第二次按键（间隔 8 ms，
+// 一帧内连按两次，第二次应留到下一帧生效）。蛇从不向左走，所以不会撞到自己；地图 1024x1024，测试期间不会结束
+// 延迟在 SimulationThread 中统计：转向生效的逻辑帧执行时刻 - 按键时刻；不超过一个步长即在下一帧生效
+#include "GameCore.h"
+#include "LatencyHistogram.h"
+#include "Random.h"
+#include "Replay.h"
+#include "SimulationThread.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+const int SIZE = 1024;
+const int DOUBLE_TAP_MS = 8; // 连按时两次按键的间隔
+
+// 随机选一个不向左的方向
+Snake::Direction randomTurn(Random& random) {
+    const Snake::Direction turns[3] = {Snake::Up, Snake::Down, Snake::Right};
+    return turns[random.bounded(3)];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int stepMs = argc > 1 ? std::atoi(argv[1]) : 50;
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 10;
+    const int doubleTapPercent = argc > 3 ? std::atoi(argv[3]) : 30;
+    const qint64 stepNanos = static_cast<qint64>(stepMs) * 1000000;
+
+    GameCore core(SIZE, SIZE);
+    core.reset(1, false);
+    Replay replay;
+    replay.begin(SIZE, SIZE, false, 3, 1);
+    SimulationThread simulation;
+    simulation.start(core, replay, false, 0, stepNanos);
+
+    Random random(7);
+    int presses = 0;
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20 + random.bounded(101)));
+        simulation.pushInput(randomTurn(random));
+        ++presses;
+        if (random.bounded(100) < doubleTapPercent) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(DOUBLE_TAP_MS));
+            simulation.pushInput(randomTurn(random));
+            ++presses;
+        }
+        simulation.poll();
+    }
+    simulation.stop();
+    simulation.poll();
+    const SimulationThread::Frame& frame = simulation.frame();
+    const SimulationThread::InputStats& input = frame.input;
+    const LatencyHistogram& latency = input.latency;
+
+    // 在下一帧生效的输入：延迟不超过一个步长（按桶统计，精度 1 ms）
+    quint64 nextTick = 0;
+    for (int i = 0; i < LatencyHistogram::BUCKETS && i * LatencyHistogram::BUCKET_NANOS < stepNanos; ++i) {
+        nextTick += latency.bucket(i);
+    }
+
+    std::printf("step %d ms, %d s, %d%% double taps, %d presses, %llu ticks%s\n", stepMs, seconds,
+                doubleTapPercent, presses, static_cast<unsigned long long>(frame.stats.ticks),
+                frame.finished ? " (game ended early)" : "");
+    std::printf("applied %llu  deferred %llu  ignored %llu  dropped %llu\n",
+                static_cast<unsigned long long>(latency.count()),
+                static_cast<unsigned long long>(input.deferredTurns),
+                static_cast<unsigned long long>(input.ignoredTurns),
+                static_cast<unsigned long long>(input.droppedTurns));
+    std::printf("latency ms: mean %.2f  p50 %.0f  p90 %.0f  p99 %.0f  max %.2f\n", latency.mean() / 1e6,
+                latency.percentile(50) / 1e6, latency.percentile(90) / 1e6, latency.percentile(99) / 1e6,
+                latency.max() / 1e6);
+    std::printf("applied on the next tick: %.1f%%\n",
+                latency.count() ? 100.0 * nextTick / latency.count() : 0.0);
+    return 0;
+}
\ No newline at end of file
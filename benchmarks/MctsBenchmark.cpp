@@ -0,0 +1,103 @@
+// MctsBenchmark：蒙特卡洛树搜索智能体的每秒模拟次数、每步树的大小与对局成绩，以及局面克隆的开销
+// 用法：SnakeMctsBenchmark [每步预算(ms)] [线程数] [局数] [地图边长]
+// 先比较克隆一个局面的耗时：复制整个 GameCore（蛇身环形缓冲区、分块占用位图、障碍物列表与位图、
+// 空闲格子集合）与 RolloutState::copyFrom()（只复制蛇身与一维占用位图，障碍物位图共享）；
+// 再以给定的每步时间预算玩若干局（第 i 局种子为 i，障碍物地图），判定打转的规则与 Arena 相同；
+// transpositions 为每步经置换表链接到已有节点（不同走法顺序到达同一局面）的次数
+//   SnakeMctsBenchmark 5 1 3       每步 5 ms、单线程
+//   SnakeMctsBenchmark 5 8 3       每步 5 ms、8 个线程共享一棵树（虚拟损失）
+#include "Arena.h"
+#include "Autopilot.h"
+#include "GameCore.h"
+#include "MctsAgent.h"
+#include "RolloutState.h"
+#include "WorkStealingPool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+const int CLONES = 200000;
+const int WARMUP_STEPS = 400; // 测克隆开销前先走若干步，让蛇身变长
+volatile quint64 sink;        // 防止克隆被优化掉
+
+double nanosSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// 克隆开销：返回两种克隆方式每次的纳秒数
+void measureClones(int size, double& coreNanos, double& rolloutNanos, int& length) {
+    GameCore core(size, size);
+    core.reset(1, true);
+    Autopilot autopilot(size, size);
+    for (int i = 0; i < WARMUP_STEPS && !core.isGameOver(); ++i) {
+        core.step(autopilot.choose(core));
+    }
+    length = core.getSnake().getLength();
+
+    GameCore copy;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < CLONES; ++i) {
+        copy = core;
+        sink = copy.getTickCount();
+    }
+    coreNanos = nanosSince(begin) / CLONES;
+
+    RolloutState::Obstacles obstacles;
+    obstacles.load(core);
+    RolloutState source;
+    source.load(core, &obstacles);
+    RolloutState clone;
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < CLONES; ++i) {
+        clone.copyFrom(source);
+        sink = static_cast<quint64>(clone.getHead());
+    }
+    rolloutNanos = nanosSince(begin) / CLONES;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double budgetMs = argc > 1 ? std::atof(argv[1]) : 5.0;
+    const int threads = argc > 2 ? std::atoi(argv[2]) : 1;
+    const int games = argc > 3 ? std::atoi(argv[3]) : 3;
+    const int size = argc > 4 ? std::atoi(argv[4]) : 20;
+
+    double coreNanos = 0;
+    double rolloutNanos = 0;
+    int length = 0;
+    measureClones(size, coreNanos, rolloutNanos, length);
+    std::printf("clone (%dx%d, snake length %d): GameCore %.0f ns, RolloutState %.0f ns (%.1fx)\n",
+                size, size, length, coreNanos, rolloutNanos, coreNanos / rolloutNanos);
+
+    WorkStealingPool pool(threads);
+    MctsAgent agent(&pool);
+    MctsAgent::Config config;
+    config.budgetNanos = static_cast<qint64>(budgetMs * 1e6);
+    agent.setConfig(config);
+    GameCore core(size, size);
+    Autopilot autopilot(size, size);
+    quint64 totalScore = 0;
+    for (int i = 1; i <= games; ++i) {
+        const Arena::Outcome outcome = Arena::play(Arena::MctsPolicy, core, autopilot, agent, static_cast<quint64>(i), true);
+        totalScore += static_cast<quint64>(core.getScore());
+        std::printf("game %d: score %d, %llu ticks, %s\n", i, core.getScore(),
+                    static_cast<unsigned long long>(core.getTickCount()),
+                    outcome == Arena::Completed ? "completed" : outcome == Arena::Stalled ? "stalled" : "died");
+    }
+
+    const MctsAgent::Stats& stats = agent.getStats();
+    const quint64 searched = stats.decisions - stats.forcedMoves;
+    std::printf("budget:                %.2f ms per move, %d threads\n", budgetMs, agent.threads());
+    std::printf("mean score:            %.1f\n", games > 0 ? double(totalScore) / games : 0.0);
+    std::printf("decisions:             %llu (%llu forced)\n", static_cast<unsigned long long>(stats.decisions),
+                static_cast<unsigned long long>(stats.forcedMoves));
+    std::printf("playouts/s:            %.0f\n", stats.playoutsPerSecond());
+    std::printf("playouts per move:     %.0f\n", searched ? double(stats.playouts) / searched : 0.0);
+    std::printf("tree nodes per move:   %.0f\n", searched ? double(stats.nodes) / searched : 0.0);
+    std::printf("transpositions/move:   %.1f\n", searched ? double(stats.transpositions) / searched : 0.0);
+    std::printf("peak arena per move:   %.1f KiB\n", stats.peakArenaBytes / 1024.0);
+    return 0;
+}
\ No newline at end of file
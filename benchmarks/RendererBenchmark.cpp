@@ -0,0 +1,169 @@
+// RendererBenchmark：比较棋盘的 QPainter 绘制与 OpenGL 实例化绘制每帧耗时
+// 用法：SnakeRendererBenchmark [地图边长] [帧数] [预热帧数]
+// 两条路径每帧绘制同一局面（障碍物地图 + 蛇身 + 食物），目标都是 500x500 像素（窗口中棋盘的大小）：
+//   QPainter：在 QImage 上逐格 fillRect，相当于 GameRenderer 整屏重绘棋盘时的绘制调用数
+//   OpenGL：  离屏帧缓冲中收集实例、上传动态部分并一次 glDrawArraysInstanced，glFinish 后计时
+// 没有 GPU 的 CI 上可用 Mesa 软件光栅化器（llvmpipe）运行：
+//   xvfb-run -a env LIBGL_ALWAYS_SOFTWARE=1 ./SnakeRendererBenchmark
+#include "GameCore.h"
+#include "InstancedBoardRenderer.h"
+#include <QGuiApplication>
+#include <QImage>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QPainter>
+#include <QSurfaceFormat>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+const int PIXELS = 500;
+
+// 判断两个方向是否相反（蛇不能直接掉头）
+bool isReverse(Snake::Direction a, Snake::Direction b) {
+    return (a == Snake::Up && b == Snake::Down) || (a == Snake::Down && b == Snake::Up)
+        || (a == Snake::Left && b == Snake::Right) || (a == Snake::Right && b == Snake::Left);
+}
+
+// 简单的策略：优先朝食物方向走，避开会立即死亡的格子
+Snake::Direction choose(const GameCore& core) {
+    const Snake& snake = core.getSnake();
+    const QPoint head = snake.getHead();
+    const QPoint food = core.getFood().getPosition();
+    const Snake::Direction order[4] = {
+        food.x() > head.x() ? Snake::Right : Snake::Left,
+        food.y() > head.y() ? Snake::Down : Snake::Up,
+        food.x() > head.x() ? Snake::Left : Snake::Right,
+        food.y() > head.y() ? Snake::Up : Snake::Down,
+    };
+    for (Snake::Direction dir : order) {
+        if (isReverse(dir, snake.getDirection())) continue;
+        QPoint next = head;
+        switch (dir) {
+            case Snake::Up:    next.ry() -= 1; break;
+            case Snake::Down:  next.ry() += 1; break;
+            case Snake::Left:  next.rx() -= 1; break;
+            case Snake::Right: next.rx() += 1; break;
+        }
+        if (snake.getOccupancy().contains(next) && !snake.isOccupied(next)
+            && core.getFreeCells().contains(next)) {
+            return dir;
+        }
+    }
+    return snake.getDirection();
+}
+
+// 推进一帧，游戏结束时用下一个种子重开
+void advance(GameCore& core, quint64& seed) {
+    core.step(choose(core));
+    if (core.isGameOver()) core.reset(++seed, true);
+}
+
+// QPainter 路径：逐格绘制整张棋盘
+void paintBoard(QPainter& painter, const GameCore& core, const InstancedBoardRenderer& colors) {
+    painter.fillRect(QRectF(0, 0, core.getWidth(), core.getHeight()), QColor(30, 30, 40));
+    for (const QPoint& p : core.getObstacles()) {
+        painter.fillRect(QRectF(p.x(), p.y(), 1, 1), colors.color(InstancedBoardRenderer::ObstacleCell));
+    }
+    const Snake& snake = core.getSnake();
+    const qint64 tick = static_cast<qint64>(core.getTickCount());
+    for (int i = snake.getLength() - 1; i >= 1; --i) {
+        const Snake::CellIndex cell = snake.cellAt(i);
+        const int serial = static_cast<int>(((tick - i) % InstancedBoardRenderer::BODY_COLORS
+                                             + InstancedBoardRenderer::BODY_COLORS) % InstancedBoardRenderer::BODY_COLORS);
+        painter.fillRect(QRectF(cell % core.getWidth(), cell / core.getWidth(), 1, 1),
+                         colors.color(InstancedBoardRenderer::BodyCell + serial));
+    }
+    const QPoint head = snake.getHead();
+    painter.fillRect(QRectF(head.x(), head.y(), 1, 1), colors.color(InstancedBoardRenderer::HeadCell));
+    const QPoint food = core.getFood().getPosition();
+    painter.fillRect(QRectF(food.x(), food.y(), 1, 1), colors.color(InstancedBoardRenderer::FoodCell));
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QGuiApplication app(argc, argv);
+    const int size = argc > 1 ? std::atoi(argv[1]) : 1024;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 200;
+    const int warmup = argc > 3 ? std::atoi(argv[3]) : 20000;
+
+    // 准备局面：障碍物地图上先走若干帧，让蛇身变长
+    GameCore start(size, size);
+    quint64 startSeed = 1;
+    start.reset(startSeed, true);
+    for (int i = 0; i < warmup; ++i) advance(start, startSeed);
+
+    // QPainter 路径
+    InstancedBoardRenderer board;
+    QImage image(PIXELS, PIXELS, QImage::Format_ARGB32_Premultiplied);
+    GameCore core = start;
+    quint64 seed = startSeed;
+    double painterMs = 0;
+    for (int i = 0; i < frames; ++i) {
+        advance(core, seed);
+        const auto begin = std::chrono::steady_clock::now();
+        QPainter painter(&image);
+        painter.setPen(Qt::NoPen);
+        painter.scale(qreal(PIXELS) / size, qreal(PIXELS) / size);
+        paintBoard(painter, core, board);
+        painter.end();
+        painterMs += millisecondsSince(begin);
+    }
+
+    // OpenGL 路径：离屏上下文 + 帧缓冲对象
+    QSurfaceFormat surfaceFormat;
+    surfaceFormat.setVersion(3, 3);
+    surfaceFormat.setProfile(QSurfaceFormat::CoreProfile);
+    QOpenGLContext context;
+    context.setFormat(surfaceFormat);
+    QOffscreenSurface surface;
+    if (!context.create()) {
+        std::printf("OpenGL context creation failed\n");
+        return 1;
+    }
+    surface.setFormat(context.format());
+    surface.create();
+    if (!context.makeCurrent(&surface) || !board.initialize()) {
+        std::printf("OpenGL 3.3 / ES 3.0 is not available\n");
+        return 1;
+    }
+    QOpenGLFunctions* gl = context.functions();
+    QOpenGLFramebufferObject framebuffer(PIXELS, PIXELS);
+    framebuffer.bind();
+    core = start;
+    seed = startSeed;
+    board.sync(core);
+    board.render(PIXELS, PIXELS); // 首帧上传障碍物，不计入
+    gl->glFinish();
+    double openglMs = 0;
+    for (int i = 0; i < frames; ++i) {
+        advance(core, seed);
+        const auto begin = std::chrono::steady_clock::now();
+        board.sync(core);
+        board.render(PIXELS, PIXELS);
+        gl->glFinish();
+        openglMs += millisecondsSince(begin);
+    }
+    const QByteArray rendererName(reinterpret_cast<const char*>(gl->glGetString(GL_RENDERER)));
+    framebuffer.release();
+    board.release();
+    context.doneCurrent();
+
+    std::printf("board:                  %dx%d, %d obstacles, snake length %d\n", size, size,
+                static_cast<int>(start.getObstacles().size()), start.getSnake().getLength());
+    std::printf("frames:                 %d (%d cells in the last frame)\n", frames, board.instanceCount());
+    std::printf("renderer:               %s\n", rendererName.constData());
+    std::printf("QPainter ms/frame:      %.3f\n", painterMs / frames);
+    std::printf("OpenGL ms/frame:        %.3f\n", openglMs / frames);
+    std::printf("speedup:                %.2fx\n", painterMs / openglMs);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+// ReplaySeekBenchmark：录制一局很长的对局，测量 ReplayPlayer::seek() 的耗时，并检查跳转结果与逐帧回放逐位一致
+// 用法：SnakeReplaySeekBenchmark [帧数] [跳转次数] [地图边长]
+// 录像由哈密顿回路自动驾驶在无障碍地图上录制（默认 64x64，10 万帧内不会结束）；逐帧回放时记下每一帧之后的
+// 状态散列、得分与蛇长，随机跳转（向前、向后都有）后逐项比较。任何一次不一致或 p99 跳转耗时超过
+// SEEK_BUDGET_MS 时以非零状态退出（最慢一次只作参考，容易受线程调度影响）
+#include "Autopilot.h"
+#include "GameCore.h"
+#include "Random.h"
+#include "Replay.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+const double SEEK_BUDGET_MS = 1.0; // p99 跳转耗时的上限
+
+// 逐帧回放得到的一帧之后的状态
+struct State {
+    quint64 hash;
+    int score;
+    int length;
+};
+
+State stateOf(const GameCore& core) {
+    return State{core.getHash(), core.getScore(), core.getSnake().getLength()};
+}
+
+double millisSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int ticks = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int seeks = argc > 2 ? std::atoi(argv[2]) : 10000;
+    const int size = argc > 3 ? std::atoi(argv[3]) : 64;
+
+    // 录制
+    GameCore core(size, size);
+    core.reset(1, false);
+    Replay replay;
+    replay.begin(size, size, false, 1, 1);
+    Autopilot autopilot(size, size);
+    autopilot.setStrategy(Autopilot::CycleStrategy);
+    while (!core.isGameOver() && replay.getTickCount() < ticks) {
+        core.setDirection(autopilot.choose(core));
+        replay.record(core.getSnake().getDirection());
+        core.step();
+    }
+    replay.setFinalHash(core.getHash());
+
+    // 逐帧回放作为参照：states[t] 为第 t 帧之后的状态
+    std::vector<State> states;
+    states.reserve(static_cast<size_t>(replay.getTickCount()) + 1);
+    GameCore linear(size, size);
+    replay.resetCore(linear);
+    states.push_back(stateOf(linear));
+    for (int t = 0; t < replay.getTickCount(); ++t) {
+        linear.step(replay.inputAt(t));
+        states.push_back(stateOf(linear));
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    ReplayPlayer player(replay);
+    const double loadMillis = millisSince(begin);
+
+    // 随机跳转
+    Random rng(7);
+    int mismatches = 0;
+    std::vector<double> millis;
+    millis.reserve(static_cast<size_t>(seeks));
+    for (int i = 0; i < seeks; ++i) {
+        const int target = rng.bounded(replay.getTickCount() + 1);
+        begin = std::chrono::steady_clock::now();
+        player.seek(target);
+        millis.push_back(millisSince(begin));
+        const State expected = states[target];
+        const State actual = stateOf(player.getCore());
+        if (player.getTick() != target || player.getCore().getTickCount() != static_cast<quint64>(target)
+            || actual.hash != expected.hash || actual.score != expected.score || actual.length != expected.length) {
+            ++mismatches;
+        }
+    }
+
+    std::sort(millis.begin(), millis.end());
+    double totalMillis = 0;
+    for (double m : millis) totalMillis += m;
+    const double p99Millis = millis.empty() ? 0.0 : millis[millis.size() * 99 / 100];
+    const double maxMillis = millis.empty() ? 0.0 : millis.back();
+    const bool withinBudget = p99Millis <= SEEK_BUDGET_MS;
+    std::printf("board:                %dx%d\n", size, size);
+    std::printf("ticks:                %d (final score %d)\n", replay.getTickCount(), core.getScore());
+    std::printf("replay bytes:         %zu\n", replay.serialize().size());
+    std::printf("keyframes:            %d every %d ticks\n",
+                replay.getTickCount() / ReplayPlayer::KEYFRAME_INTERVAL + 1, ReplayPlayer::KEYFRAME_INTERVAL);
+    std::printf("load (ms):            %.1f\n", loadMillis);
+    std::printf("consistent:           %s\n", player.isConsistent() ? "yes" : "NO");
+    std::printf("seeks:                %d\n", seeks);
+    std::printf("mean seek (ms):       %.4f\n", seeks ? totalMillis / seeks : 0.0);
+    std::printf("p99 seek (ms):        %.4f (budget %.1f)\n", p99Millis, SEEK_BUDGET_MS);
+    std::printf("max seek (ms):        %.4f\n", maxMillis);
+    std::printf("states match linear:  %s\n", mismatches == 0 ? "yes" : "NO");
+    return mismatches == 0 && withinBudget && player.isConsistent() ? 0 : 1;
+}
\ No newline at end of file
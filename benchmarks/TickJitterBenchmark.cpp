@@ -0,0 +1,100 @@
+// TickJitterBenchmark：比较逻辑帧在界面线程中执行与在模拟线程中执行时的定时抖动，以及绘制卡顿对两者的影响
+// 用法：SnakeTickJitterBenchmark [逻辑帧步长(ms)] [每种情况运行秒数] [卡顿时每次绘制耗时(ms)]
+// “界面线程”模拟原来的结构：同一个循环里先执行到期的逻辑帧再绘制，绘制越慢逻辑帧越晚；
+// “模拟线程”由 SimulationThread 定时推进，主循环只取快照并绘制。两者的绘制都用忙等代替，
+// 轻载时每帧 2 ms，重载时每帧为命令行给出的耗时；地图为 4096x5，蛇一直向右走，测试期间不会结束
+#include "FixedTimestep.h"
+#include "GameCore.h"
+#include "Replay.h"
+#include "SimulationThread.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace {
+
+const int WIDTH = 4096;
+const int HEIGHT = 5;
+const int FRAME_MS = 16;     // 显示帧间隔
+const int LIGHT_PAINT_MS = 2; // 轻载时每次绘制的耗时
+
+// 用忙等模拟一次绘制
+void paint(int milliseconds) {
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    while (std::chrono::steady_clock::now() < end) {}
+}
+
+// 界面线程版本：每个显示帧先执行到期的逻辑帧，再绘制，再等到下一个显示帧
+SimulationThread::TickStats runOnGuiThread(qint64 stepNanos, int seconds, int paintMs) {
+    GameCore core(WIDTH, HEIGHT);
+    core.reset(1, false);
+    FixedTimestep clock;
+    clock.start(stepNanos);
+    SimulationThread::TickStats stats;
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    auto nextFrame = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() < end) {
+        const int due = clock.advance();
+        const qint64 now = clock.elapsed();
+        for (int k = 0; k < due; ++k) {
+            const qint64 jitter = now - (clock.lastTickDue() - static_cast<qint64>(due - 1 - k) * stepNanos);
+            ++stats.ticks;
+            stats.totalJitterNanos += jitter;
+            stats.maxJitterNanos = std::max(stats.maxJitterNanos, jitter);
+            if (jitter >= stepNanos) ++stats.lateTicks;
+            core.step();
+        }
+        paint(paintMs);
+        nextFrame += std::chrono::milliseconds(FRAME_MS);
+        std::this_thread::sleep_until(nextFrame);
+    }
+    stats.droppedTicks = clock.droppedTicks();
+    return stats;
+}
+
+// 模拟线程版本：主循环只取快照并绘制
+SimulationThread::TickStats runOnSimulationThread(qint64 stepNanos, int seconds, int paintMs) {
+    GameCore core(WIDTH, HEIGHT);
+    core.reset(1, false);
+    Replay replay;
+    replay.begin(WIDTH, HEIGHT, false, 2, 1);
+    SimulationThread simulation;
+    simulation.start(core, replay, false, 0, stepNanos);
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    auto nextFrame = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() < end) {
+        simulation.poll();
+        paint(paintMs);
+        nextFrame += std::chrono::milliseconds(FRAME_MS);
+        std::this_thread::sleep_until(nextFrame);
+    }
+    simulation.stop();
+    simulation.poll();
+    return simulation.frame().stats;
+}
+
+void report(const char* name, const SimulationThread::TickStats& stats) {
+    std::printf("%-28s ticks %5llu  mean %7.3f ms  max %7.3f ms  late %4llu  dropped %4llu\n", name,
+                static_cast<unsigned long long>(stats.ticks), stats.meanJitterNanos() / 1e6,
+                stats.maxJitterNanos / 1e6, static_cast<unsigned long long>(stats.lateTicks),
+                static_cast<unsigned long long>(stats.droppedTicks));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int stepMs = argc > 1 ? std::atoi(argv[1]) : 10;
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 3;
+    const int heavyPaintMs = argc > 3 ? std::atoi(argv[3]) : 40;
+    const qint64 stepNanos = static_cast<qint64>(stepMs) * 1000000;
+
+    std::printf("step %d ms, %d s per case, frame every %d ms, paint %d ms (light) / %d ms (heavy)\n",
+                stepMs, seconds, FRAME_MS, LIGHT_PAINT_MS, heavyPaintMs);
+    report("GUI thread, light paint", runOnGuiThread(stepNanos, seconds, LIGHT_PAINT_MS));
+    report("GUI thread, heavy paint", runOnGuiThread(stepNanos, seconds, heavyPaintMs));
+    report("simulation thread, light", runOnSimulationThread(stepNanos, seconds, LIGHT_PAINT_MS));
+    report("simulation thread, heavy", runOnSimulationThread(stepNanos, seconds, heavyPaintMs));
+    return 0;
+}
\ No newline at end of file
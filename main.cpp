@@ -1,11 +1,138 @@
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QCommandLineOption>
+#include <QElapsedTimer>
+#include <QScopedPointer>
+#include <algorithm>
+#include <cstdio>
 #include "SnakeGame.h"
 #include "GameRenderer.h"
 
+namespace {
+
+const int STALL_TICKS_PER_CELL = 4; // 无界面对局中连续这么多倍格子数的逻辑帧没有得分即判为打转并结束
+
+// 无界面批量对局：第 i 局使用种子 firstSeed + i - 1，由自动驾驶以最快速度跑完，最后输出统计
+int runHeadless(SnakeGame& game, int games, quint64 firstSeed) {
+    game.setHeadless(true);
+    game.setAutopilot(true);
+    qint64 totalScore = 0;
+    int maxScore = 0;
+    int completed = 0;
+    int stalled = 0;
+    quint64 ticks = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 1; i <= games; ++i) {
+        game.setSeed(firstSeed + static_cast<quint64>(i - 1));
+        game.startGame();
+        const quint64 stallTicks = static_cast<quint64>(game.getBoardWidth()) * game.getBoardHeight() * STALL_TICKS_PER_CELL;
+        int lastScore = game.getScore();
+        quint64 lastScoreTick = 0;
+        while (game.getGameState() == SnakeGame::Playing) {
+            game.update();
+            const GameCore& core = game.getCore();
+            if (core.getScore() != lastScore) {
+                lastScore = core.getScore();
+                lastScoreTick = core.getTickCount();
+            } else if (core.getTickCount() - lastScoreTick > stallTicks) {
+                game.setGameState(SnakeGame::GameOver); // 跟着蛇尾打转，吃不到剩下的食物
+                ++stalled;
+            }
+        }
+        totalScore += game.getScore();
+        maxScore = std::max(maxScore, game.getScore());
+        if (game.isBoardComplete()) ++completed;
+        ticks += game.getCore().getTickCount();
+    }
+    const double seconds = timer.nsecsElapsed() / 1e9;
+    const Autopilot::Stats& stats = game.getAutopilotStats();
+    std::printf("games:           %d (%dx%d)\n", games, game.getBoardWidth(), game.getBoardHeight());
+    std::printf("mean score:      %.1f\n", games > 0 ? double(totalScore) / games : 0.0);
+    std::printf("max score:       %d\n", maxScore);
+    std::printf("boards complete: %d\n", completed);
+    std::printf("stalled:         %d\n", stalled);
+    std::printf("ticks:           %llu (%.0f ticks/s)\n", static_cast<unsigned long long>(ticks),
+                seconds > 0 ? ticks / seconds : 0.0);
+    std::printf("decisions:       path %llu, follow tail %llu, max space %llu, trapped %llu, cycle %llu, shortcut %llu\n",
+                static_cast<unsigned long long>(stats.pathMoves), static_cast<unsigned long long>(stats.tailMoves),
+                static_cast<unsigned long long>(stats.spaceMoves), static_cast<unsigned long long>(stats.trappedMoves),
+                static_cast<unsigned long long>(stats.cycleMoves), static_cast<unsigned long long>(stats.shortcutMoves));
+    return 0;
+}
+
+} // namespace
+
 int main(int argc, char *argv[]) {
-    QApplication app(argc, argv);
+    // 无界面模式不创建窗口系统连接（可在没有显示器的机器上批量运行）
+    bool headless = false;
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--headless") == 0) headless = true;
+    }
+    QScopedPointer<QCoreApplication> app(headless ? new QCoreApplication(argc, argv) : new QApplication(argc, argv));
+
+    // 命令行参数：--board=WxH 指定地图尺寸（默认 20x20），--replay <file> 重放录像，
+    // --renderer=painter|opengl 选择棋盘绘制后端，--autopilot 开启自动驾驶（--strategy=astar|cycle 选择策略），
+    // --headless [--games=N] 不显示窗口、由自动驾驶连续跑 N 局并输出统计，--seed=S 指定（第一局的）随机种子
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption boardOption("board", "Board size, e.g. 64x48 (max 4096x4096).", "WxH");
+    parser.addOption(boardOption);
+    QCommandLineOption replayOption("replay", "Play back a recorded game.", "file");
+    parser.addOption(replayOption);
+    QCommandLineOption rendererOption("renderer", "Board renderer: painter (default) or opengl.", "backend", "painter");
+    parser.addOption(rendererOption);
+    QCommandLineOption autopilotOption("autopilot", "Let the built-in autopilot steer the snake.");
+    parser.addOption(autopilotOption);
+    QCommandLineOption strategyOption("strategy", "Autopilot strategy: astar (default) or cycle (Hamiltonian cycle).",
+                                      "name", "astar");
+    parser.addOption(strategyOption);
+    QCommandLineOption headlessOption("headless", "Run autopilot games without a window and print statistics.");
+    parser.addOption(headlessOption);
+    QCommandLineOption gamesOption("games", "Number of games to run with --headless (default 100).", "N", "100");
+    parser.addOption(gamesOption);
+    QCommandLineOption obstaclesOption("obstacles", "Use the obstacle map.");
+    parser.addOption(obstaclesOption);
+    QCommandLineOption seedOption("seed", "Random seed of the first game (reproduces its map and food sequence; "
+                                  "with --headless game i uses seed S + i - 1, default 1).", "S");
+    parser.addOption(seedOption);
+    parser.process(*app);
+
     SnakeGame game;
+    if (parser.isSet(boardOption)) {
+        const QStringList size = parser.value(boardOption).split('x');
+        if (size.size() == 2) {
+            game.setBoardSize(size[0].toInt(), size[1].toInt());
+        }
+    }
+    if (parser.isSet(obstaclesOption)) {
+        game.setSelectedMap(SnakeGame::ObstacleMap);
+    }
+    if (parser.value(strategyOption) == "cycle") {
+        game.setAutopilotStrategy(Autopilot::CycleStrategy);
+    }
+    bool seedValid = false;
+    const quint64 seed = parser.value(seedOption).toULongLong(&seedValid);
+    if (parser.isSet(seedOption) && !seedValid) {
+        std::fprintf(stderr, "Invalid --seed value: %s\n", qPrintable(parser.value(seedOption)));
+        return 1;
+    }
+    if (headless) {
+        return runHeadless(game, parser.value(gamesOption).toInt(), seedValid ? seed : 1);
+    }
+    if (seedValid) {
+        game.setSeed(seed); // 只作用于下一局（重放录像时由录像的种子覆盖）
+    }
+    game.setAutopilot(parser.isSet(autopilotOption));
     GameRenderer renderer(&game);
+    if (parser.value(rendererOption) == "opengl") {
+        renderer.setBoardBackend(GameRenderer::OpenGLBackend);
+    }
     renderer.show();
-    return app.exec();
+    if (parser.isSet(replayOption)) {
+        if (game.loadReplay(parser.value(replayOption))) {
+            game.startGame();
+        }
+    }
+    return app->exec();
 }
\ No newline at end of file
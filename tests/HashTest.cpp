@@ -0,0 +1,131 @@
+// HashTest：检查增量维护的状态散列与从头计算的结果一致
+// 用法：SnakeHashTest [局数]
+// GameCore：各种尺寸、有无障碍的地图上分别用随机方向与自动驾驶推进，每一帧之后把 getHash() 与按蛇身、
+// 方向、生长标记和食物位置从头异或出的散列比较；RolloutState：从对局中途载入后与 GameCore 同步推进，
+// 散列在吃到食物之前逐帧相同（之后两边的食物随机数不同），hashAfter() 与实际推进后的散列相同。
+// 有任何不一致时以非零状态退出
+#include "Autopilot.h"
+#include "GameCore.h"
+#include "Random.h"
+#include "RolloutState.h"
+#include "Zobrist.h"
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+const int MAX_TICKS = 5000;       // 每局最多推进的帧数
+const int ROLLOUT_STEPS = 200;    // RolloutState 与 GameCore 同步推进的最多帧数
+
+// 按定义从头计算 GameCore 的状态散列
+quint64 fullHash(const GameCore& core) {
+    const Snake& snake = core.getSnake();
+    const int length = snake.getLength();
+    quint64 hash = 0;
+    for (int i = 0; i < length; ++i) {
+        hash ^= Zobrist::body(snake.cellAt(i));
+    }
+    if (length > 0) {
+        hash ^= Zobrist::head(snake.cellAt(0)) ^ Zobrist::tail(snake.cellAt(length - 1));
+    }
+    hash ^= Zobrist::direction(snake.getDirection());
+    if (snake.isGrowing()) hash ^= Zobrist::growing();
+    const QPoint food = core.getFood().getPosition();
+    if (food.x() >= 0) hash ^= Zobrist::food(food.y() * core.getWidth() + food.x());
+    return hash;
+}
+
+// 去掉食物一项的散列（吃到食物后两边新食物的位置不同）
+quint64 withoutFood(quint64 hash, int food) {
+    return food < 0 ? hash : hash ^ Zobrist::food(food);
+}
+
+// GameCore 增量散列与从头计算的散列，返回不一致的帧数
+long long checkCore(int games, long long& checks) {
+    long long mismatches = 0;
+    Random rng(5);
+    for (int g = 0; g < games; ++g) {
+        GameCore core(10 + g % 7, 8 + g % 5);
+        core.reset(g, g % 2 == 1);
+        Autopilot autopilot(core.getWidth(), core.getHeight());
+        if (fullHash(core) != core.getHash()) ++mismatches;
+        while (!core.isGameOver() && core.getTickCount() < MAX_TICKS) {
+            const Snake::Direction dir =
+                g % 3 == 0 ? static_cast<Snake::Direction>(rng.bounded(4)) : autopilot.choose(core);
+            core.step(dir);
+            ++checks;
+            if (fullHash(core) != core.getHash()) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// RolloutState 散列与 GameCore 散列，返回不一致的次数
+long long checkRollout(int games, long long& checks) {
+    long long mismatches = 0;
+    Random rng(3);
+    for (int g = 0; g < games; ++g) {
+        GameCore core(12, 10);
+        core.reset(g, g % 2 == 1);
+        Autopilot autopilot(core.getWidth(), core.getHeight());
+        const int warmup = rng.bounded(300);
+        for (int i = 0; i < warmup && !core.isGameOver(); ++i) {
+            core.step(autopilot.choose(core));
+        }
+        if (core.isGameOver()) continue;
+
+        RolloutState::Obstacles obstacles;
+        obstacles.load(core);
+        RolloutState loaded;
+        loaded.load(core, &obstacles);
+        RolloutState state;
+        state.copyFrom(loaded);
+        ++checks;
+        if (state.getHash() != core.getHash()) ++mismatches;
+
+        Random rolloutRng(g);
+        for (int k = 0; k < ROLLOUT_STEPS && !core.isGameOver(); ++k) {
+            const Snake::Direction dir = autopilot.choose(core);
+            const bool eats = state.neighbor(dir) == state.getFood();
+            const bool safe = state.isSafe(dir);
+            const quint64 predicted = safe ? state.hashAfter(dir) : 0;
+            const RolloutState::Result result = state.step(dir, rolloutRng);
+            core.step(dir);
+            ++checks;
+            if (safe && result == RolloutState::Moved && predicted != state.getHash()) ++mismatches;
+            if (eats) {
+                const QPoint food = core.getFood().getPosition();
+                const int coreFood = food.x() < 0 ? -1 : food.y() * core.getWidth() + food.x();
+                if (withoutFood(core.getHash(), coreFood) != withoutFood(state.getHash(), state.getFood())) {
+                    ++mismatches;
+                }
+                break;
+            }
+            if (result == RolloutState::Moved && state.getHash() != core.getHash()) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int games = argc > 1 ? std::atoi(argv[1]) : 300;
+
+    long long coreChecks = 0;
+    const long long coreMismatches = checkCore(games, coreChecks);
+    long long rolloutChecks = 0;
+    const long long rolloutMismatches = checkRollout(games, rolloutChecks);
+
+    // 相同种子必须得到相同的初始状态
+    GameCore first(20, 20);
+    GameCore second(20, 20);
+    first.reset(7, true);
+    second.reset(7, true);
+    const bool seedStable = first.getHash() == second.getHash();
+
+    std::printf("GameCore checks:      %lld (mismatches %lld)\n", coreChecks, coreMismatches);
+    std::printf("RolloutState checks:  %lld (mismatches %lld)\n", rolloutChecks, rolloutMismatches);
+    std::printf("same seed same hash:  %s\n", seedStable ? "yes" : "NO");
+    return coreMismatches == 0 && rolloutMismatches == 0 && seedStable ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+// ReplayTest：检查录像的序列化往返、结束状态散列的校验与对损坏文件的拒绝
+// 用法：SnakeReplayTest
+// 用自动驾驶在障碍物地图上录制一局，序列化后再读回：各字段与输入逐帧相同，ReplayPlayer 重放后与录制时的
+// 散列一致，任意跳转与逐帧回放一致；篡改结束散列或一帧输入后 ReplayPlayer 必须报告不一致；
+// 截断的数据、错误的文件头与超出范围的地图尺寸必须被 deserialize() 拒绝。有任何一项失败时以非零状态退出
+#include "Autopilot.h"
+#include "GameCore.h"
+#include "Random.h"
+#include "Replay.h"
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const int BOARD_SIZE = 20;
+const int MAX_TICKS = 3000; // 录制的最多帧数
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    std::printf("%-40s %s\n", what, condition ? "ok" : "FAILED");
+    if (!condition) ++failures;
+}
+
+// 读回一份字节流，成功时返回 true
+bool load(const std::vector<quint8>& bytes, Replay& replay) {
+    return replay.deserialize(bytes.data(), bytes.size());
+}
+
+// 按 Replay::serialize() 的格式写一个只有文件头的录像（宽、高可以任意）
+std::vector<quint8> headerOnly(int width, int height) {
+    Replay replay;
+    replay.begin(BOARD_SIZE, BOARD_SIZE, false, 1, 1);
+    std::vector<quint8> bytes = replay.serialize();
+    // 文件头之后依次是宽、高（都小于 128 时各占一个字节）
+    bytes[5] = static_cast<quint8>(width);
+    bytes[6] = static_cast<quint8>(height);
+    return bytes;
+}
+
+} // namespace
+
+int main() {
+    // 录制
+    GameCore core(BOARD_SIZE, BOARD_SIZE);
+    core.reset(9, true);
+    Replay replay;
+    replay.begin(BOARD_SIZE, BOARD_SIZE, true, 2, 9);
+    Autopilot autopilot(BOARD_SIZE, BOARD_SIZE);
+    while (!core.isGameOver() && replay.getTickCount() < MAX_TICKS) {
+        core.setDirection(autopilot.choose(core));
+        replay.record(core.getSnake().getDirection());
+        core.step();
+    }
+    replay.setFinalHash(core.getHash());
+    const std::vector<quint8> bytes = replay.serialize();
+
+    // 往返
+    Replay loaded;
+    check(load(bytes, loaded), "round trip parses");
+    bool inputsMatch = loaded.getTickCount() == replay.getTickCount();
+    for (int t = 0; inputsMatch && t < replay.getTickCount(); ++t) {
+        inputsMatch = loaded.inputAt(t) == replay.inputAt(t);
+    }
+    check(inputsMatch, "round trip keeps every input");
+    check(loaded.getWidth() == BOARD_SIZE && loaded.getHeight() == BOARD_SIZE && loaded.isObstacleMap()
+              && loaded.getDifficulty() == 2 && loaded.getSeed() == 9,
+          "round trip keeps the header");
+    check(loaded.hasFinalHash() && loaded.getFinalHash() == core.getHash(), "round trip keeps the final hash");
+    check(loaded.serialize() == bytes, "round trip is byte-identical");
+
+    ReplayPlayer player(loaded);
+    check(player.isConsistent(), "playback matches the recording");
+    player.seek(loaded.getTickCount());
+    check(player.getCore().getHash() == core.getHash() && player.getCore().getScore() == core.getScore(),
+          "seek to the end matches the recording");
+
+    // 随机跳转与逐帧回放一致
+    std::vector<quint64> hashes;
+    GameCore linear(BOARD_SIZE, BOARD_SIZE);
+    loaded.resetCore(linear);
+    hashes.push_back(linear.getHash());
+    for (int t = 0; t < loaded.getTickCount(); ++t) {
+        linear.step(loaded.inputAt(t));
+        hashes.push_back(linear.getHash());
+    }
+    Random rng(11);
+    bool seeksMatch = true;
+    for (int i = 0; i < 200; ++i) {
+        const int target = rng.bounded(loaded.getTickCount() + 1);
+        player.seek(target);
+        seeksMatch = seeksMatch && player.getTick() == target && player.getCore().getHash() == hashes[target];
+    }
+    check(seeksMatch, "random seeks match linear playback");
+
+    // 篡改
+    Replay tamperedHash = loaded;
+    tamperedHash.setFinalHash(loaded.getFinalHash() ^ 1);
+    check(!ReplayPlayer(tamperedHash).isConsistent(), "tampered final hash is detected");
+
+    std::vector<quint8> tamperedBytes = bytes;
+    // 输入流位于末尾，改写第一个字节中全部四帧的方向
+    tamperedBytes[bytes.size() - (replay.getTickCount() + 3) / 4] ^= 0x55;
+    Replay tamperedInput;
+    check(load(tamperedBytes, tamperedInput) && !ReplayPlayer(tamperedInput).isConsistent(),
+          "tampered input is detected");
+
+    // 损坏或超出范围的数据
+    Replay rejected;
+    std::vector<quint8> truncated(bytes.begin(), bytes.end() - 1);
+    check(!load(truncated, rejected), "truncated input is rejected");
+    std::vector<quint8> badMagic = bytes;
+    badMagic[0] = 'X';
+    check(!load(badMagic, rejected), "bad magic is rejected");
+    check(load(headerOnly(GameCore::MIN_SIZE, GameCore::MIN_SIZE), rejected), "minimum board size is accepted");
+    check(!load(headerOnly(GameCore::MIN_SIZE - 1, BOARD_SIZE), rejected), "too narrow board is rejected");
+    check(!load(headerOnly(BOARD_SIZE, GameCore::MIN_SIZE - 1), rejected), "too short board is rejected");
+
+    std::printf("ticks recorded: %d, failures: %d\n", replay.getTickCount(), failures);
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+// snake-arena：无界面自我对弈锦标赛，在工作窃取线程池上批量运行对局并按策略汇总成绩
+// 用法：snake-arena [--games=N] [--policies=greedy,astar,cycle] [--threads=N] [--board=WxH] [--obstacles]
+//                   [--seed=S] [--grain=N] [--no-timing]
+// 第 i 局的种子为 Arena::seedFor(S, i)，所有策略使用同一组种子。除 timing 部分外，报告与线程数无关，
+// 例如 `snake-arena --threads=1 --no-timing` 与 `snake-arena --threads=64 --no-timing` 的输出逐字节相同
+#include "Arena.h"
+#include "WorkStealingPool.h"
+#include <QCoreApplication>
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QStringList>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+double average(quint64 total, quint64 count) {
+    return count ? double(total) / count : 0.0;
+}
+
+void printReport(const Arena::Config& config, const Arena::Report& report, bool timing) {
+    std::printf("board %dx%d %s, %llu games per policy, base seed %llu\n", config.width, config.height,
+                config.obstacleMap ? "obstacles" : "empty", static_cast<unsigned long long>(config.games),
+                static_cast<unsigned long long>(config.baseSeed));
+    std::printf("%-8s %10s %10s %6s %6s %10s %12s %10s %10s %10s  %-16s\n", "policy", "games", "mean score", "min",
+                "max", "mean len", "mean ticks", "died", "stalled", "completed", "checksum");
+    for (size_t p = 0; p < report.policies.size(); ++p) {
+        const Arena::PolicyStats& stats = report.stats[p];
+        std::printf("%-8s %10llu %10.2f %6d %6d %10.2f %12.1f %10llu %10llu %10llu  %016llx\n",
+                    Arena::policyName(report.policies[p]), static_cast<unsigned long long>(stats.games),
+                    average(stats.totalScore, stats.games), stats.minScore, stats.maxScore,
+                    average(stats.totalLength, stats.games), average(stats.totalTicks, stats.games),
+                    static_cast<unsigned long long>(stats.died), static_cast<unsigned long long>(stats.stalled),
+                    static_cast<unsigned long long>(stats.completed), static_cast<unsigned long long>(stats.checksum));
+    }
+    if (!timing) return;
+    // 以下数值与机器负载和线程数有关，不参与比对
+    std::printf("\ntiming: %d threads, %llu steals, wall %.3f s\n", report.threads,
+                static_cast<unsigned long long>(report.steals), report.wallNanos / 1e9);
+    for (size_t p = 0; p < report.policies.size(); ++p) {
+        const Arena::PolicyStats& stats = report.stats[p];
+        std::printf("%-8s %14.0f ticks/s per thread\n", Arena::policyName(report.policies[p]),
+                    stats.nanos > 0 ? stats.totalTicks / (stats.nanos / 1e9) : 0.0);
+    }
+    quint64 ticks = 0;
+    for (const Arena::PolicyStats& stats : report.stats) {
+        ticks += stats.totalTicks;
+    }
+    std::printf("%-8s %14.0f ticks/s (wall clock, all threads)\n", "total",
+                report.wallNanos > 0 ? ticks / (report.wallNanos / 1e9) : 0.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption gamesOption("games", "Games per policy (default 1000).", "N", "1000");
+    parser.addOption(gamesOption);
+    QCommandLineOption policiesOption("policies", "Comma-separated policies: greedy, astar, cycle, mcts.", "list",
+                                      "greedy,astar,cycle");
+    parser.addOption(policiesOption);
+    QCommandLineOption threadsOption("threads", "Worker threads (default: all cores).", "N", "0");
+    parser.addOption(threadsOption);
+    QCommandLineOption boardOption("board", "Board size (default 20x20).", "WxH", "20x20");
+    parser.addOption(boardOption);
+    QCommandLineOption obstaclesOption("obstacles", "Use the obstacle map.");
+    parser.addOption(obstaclesOption);
+    QCommandLineOption seedOption("seed", "Base seed (default 1).", "S", "1");
+    parser.addOption(seedOption);
+    QCommandLineOption grainOption("grain", "Games taken from the work range at a time (default 16).", "N", "16");
+    parser.addOption(grainOption);
+    QCommandLineOption noTimingOption("no-timing", "Print only the thread-count independent part of the report.");
+    parser.addOption(noTimingOption);
+    parser.process(app);
+
+    Arena::Config config;
+    const QStringList size = parser.value(boardOption).split('x');
+    if (size.size() == 2) {
+        config.width = std::clamp(size[0].toInt(), GameCore::MIN_SIZE, GameCore::MAX_SIZE);
+        config.height = std::clamp(size[1].toInt(), GameCore::MIN_SIZE, GameCore::MAX_SIZE);
+    }
+    config.obstacleMap = parser.isSet(obstaclesOption);
+    config.games = parser.value(gamesOption).toULongLong();
+    config.baseSeed = parser.value(seedOption).toULongLong();
+    config.grain = parser.value(grainOption).toULongLong();
+    for (const QString& name : parser.value(policiesOption).split(',')) {
+        Arena::Policy policy;
+        if (!Arena::parsePolicy(name.trimmed().toUtf8().constData(), policy)) {
+            std::fprintf(stderr, "unknown policy: %s\n", name.toUtf8().constData());
+            return 1;
+        }
+        config.policies.push_back(policy);
+    }
+    if (config.policies.empty() || config.games * config.policies.size() > WorkStealingPool::MAX_TASKS) {
+        std::fprintf(stderr, "need 1..%llu games in total\n", static_cast<unsigned long long>(WorkStealingPool::MAX_TASKS));
+        return 1;
+    }
+
+    WorkStealingPool pool(parser.value(threadsOption).toInt());
+    const Arena::Report report = Arena::run(config, pool);
+    printReport(config, report, !parser.isSet(noTimingOption));
+    return 0;
+}
\ No newline at end of file